@@ -17,6 +17,10 @@ inline void delay(unsigned long ms) {
   std::this_thread::sleep_for(std::chrono::milliseconds(ms));
 }
 
+inline void delayMicroseconds(unsigned int us) {
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
 struct SerialType {
   void begin(unsigned long) {}
 
@@ -52,17 +56,43 @@ struct SerialType {
 #define NEO_GRB   0
 #define NEO_KHZ800 0
 
+// WS2812 전송 시간 모델 (800kHz, LED당 24bit x 1.25us)
+// 실제 show()는 전송 동안 인터럽트를 끄므로 시리얼 수신, millis(), 자석 스캔이 멈춤
+#define WS2812_US_PER_LED 30
+#define WS2812_LATCH_US 300        // 래치(reset) 최소 간격 (WS2812B)
+#define WS2812_MILLIS_TICK_US 1024 // AVR timer0 오버플로 주기 (1개만 보류됨)
+#define WS2812_UART_BYTE_US 87     // 115200bps에서 1바이트 수신 시간
+#define WS2812_UART_FIFO 2         // AVR UART 수신 버퍼 (바이트)
+#ifndef WS2812_SIMULATE_TIMING
+#define WS2812_SIMULATE_TIMING 0 // 1이면 show()가 전송 시간만큼 실제로 대기 (-D로 켬)
+#endif
+
 class Adafruit_NeoPixel {
 public:
   Adafruit_NeoPixel(int n, int /*pin*/, int /*flags*/)
-  : _n(n), _brightness(20) {
+  : _n(n), _brightness(20), _shows(0), _busyUs(0), _maxIrqOffUs(0),
+        _lostMillisUs(0), _rxOverrunBytes(0) {
     _pixels = new uint32_t[_n];
     clear();
   }
   ~Adafruit_NeoPixel() { delete[] _pixels; }
 
   void begin() {}
-  void show() {}
+  void show() {
+    unsigned long transferUs = (unsigned long)_n * WS2812_US_PER_LED;
+    _shows++;
+    _busyUs += transferUs;
+    if (transferUs > _maxIrqOffUs)
+      _maxIrqOffUs = transferUs;
+    if (transferUs > WS2812_MILLIS_TICK_US)
+      _lostMillisUs += transferUs - WS2812_MILLIS_TICK_US;
+    unsigned long rxBytes = transferUs / WS2812_UART_BYTE_US;
+    if (rxBytes > WS2812_UART_FIFO)
+      _rxOverrunBytes += rxBytes - WS2812_UART_FIFO;
+#if WS2812_SIMULATE_TIMING
+    delayMicroseconds(transferUs);
+#endif
+  }
 
   void setBrightness(uint8_t b) { _brightness = b; }
   uint8_t getBrightness() const { return _brightness; }
@@ -83,10 +113,25 @@ public:
     return 0;
   }
 
+  // 전송 시간 모델 요약: 누적 점유 시간, 최대 인터럽트 차단 구간, 최대 프레임 속도
+  void printTransferStats() const {
+    unsigned long transferUs = (unsigned long)_n * WS2812_US_PER_LED;
+    std::printf("WS2812: leds=%d shows=%lu busy_ms=%lu irq_off_max_us=%lu "
+                "millis_lost_ms=%lu max_fps=%lu rx_overrun_bytes=%lu\n",
+                _n, _shows, _busyUs / 1000, _maxIrqOffUs, _lostMillisUs / 1000,
+                1000000UL / (transferUs + WS2812_LATCH_US), _rxOverrunBytes);
+    std::fflush(stdout);
+  }
+
 private:
   int _n;
   uint8_t _brightness;
   uint32_t* _pixels;
+  unsigned long _shows;
+  unsigned long _busyUs;       // show()에 쓰인 누적 시간
+  unsigned long _maxIrqOffUs;  // 가장 긴 인터럽트 차단 구간
+  unsigned long _lostMillisUs; // 차단 중 놓친 timer0 tick
+  unsigned long _rxOverrunBytes; // 수신이 계속됐다면 차단 중 넘쳤을 UART 바이트
 };
 
 #else
@@ -141,6 +186,152 @@ int xyToIndex(int x, int y) {
 // 5. 유틸리티 함수
 // ============================================================================
 
+// 구간별 타이밍 (알고리즘 / 그리기 / 시리얼 출력)
+// -DPROFILE_PHASES=1로 빌드하면 활성화, 아니면 매크로가 모두 빈 코드가 됨
+// 중첩된 구간은 자기 시간만 기록 (예: 그리기 안의 serialPrintFrame은 io로 분리)
+#ifndef PROFILE_PHASES
+#define PROFILE_PHASES 0
+#endif
+
+#if PROFILE_PHASES
+enum Phase { PHASE_ALGO, PHASE_RENDER, PHASE_IO, PHASE_COUNT };
+
+#ifdef TARGET_PC
+#define PHASE_UNIT "ns"
+#define PHASE_SUB_BITS 2 // 2의 거듭제곱 구간을 4칸으로 나눔 (오차 25% 이내)
+static inline uint32_t phaseClock() {
+  return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+#else
+#define PHASE_UNIT "us"
+#define PHASE_SUB_BITS 0 // SRAM 절약: 2의 거듭제곱 단위
+static inline uint32_t phaseClock() { return micros(); }
+#endif
+
+#define PHASE_BUCKETS ((33 - PHASE_SUB_BITS) << PHASE_SUB_BITS)
+
+struct PhaseHistogram {
+  uint32_t count;
+  uint32_t minValue;
+  uint32_t maxValue;
+  uint32_t buckets[PHASE_BUCKETS];
+};
+
+static PhaseHistogram phaseHist[PHASE_COUNT];
+
+// 로그 스케일 버킷 번호
+static uint8_t phaseBucket(uint32_t v) {
+  if (v < (1UL << PHASE_SUB_BITS))
+    return (uint8_t)v;
+  uint8_t msb = 31;
+  while (!(v & (1UL << msb)))
+    msb--;
+  uint8_t sub = (v >> (msb - PHASE_SUB_BITS)) & ((1 << PHASE_SUB_BITS) - 1);
+  return ((msb - PHASE_SUB_BITS + 1) << PHASE_SUB_BITS) + sub;
+}
+
+// 버킷이 담당하는 최대값
+static uint32_t phaseBucketUpper(uint8_t bucket) {
+  if (bucket < (1 << PHASE_SUB_BITS))
+    return bucket;
+  uint8_t msb = (bucket >> PHASE_SUB_BITS) + PHASE_SUB_BITS - 1;
+  uint32_t sub = bucket & ((1 << PHASE_SUB_BITS) - 1);
+  uint32_t lower = (1UL << msb) | (sub << (msb - PHASE_SUB_BITS));
+  return lower + (1UL << (msb - PHASE_SUB_BITS)) - 1;
+}
+
+void phaseRecord(uint8_t phase, uint32_t elapsed) {
+  PhaseHistogram &h = phaseHist[phase];
+  if (h.count == 0 || elapsed < h.minValue)
+    h.minValue = elapsed;
+  if (elapsed > h.maxValue)
+    h.maxValue = elapsed;
+  h.count++;
+  h.buckets[phaseBucket(elapsed)]++;
+}
+
+uint32_t phaseQuantile(uint8_t phase, uint32_t permille) {
+  PhaseHistogram &h = phaseHist[phase];
+  uint32_t rank = (h.count * permille + 999) / 1000;
+  uint32_t seen = 0;
+  for (int i = 0; i < PHASE_BUCKETS; i++) {
+    seen += h.buckets[i];
+    if (seen >= rank && seen > 0) {
+      uint32_t upper = phaseBucketUpper(i);
+      return upper < h.maxValue ? upper : h.maxValue;
+    }
+  }
+  return h.maxValue;
+}
+
+// 스코프 타이머: 생성~소멸 구간을 기록, 안쪽 구간이 열리면 바깥 구간은 잠시 멈춤
+struct PhaseScope {
+  static PhaseScope *active;
+  PhaseScope *parent;
+  uint32_t start;
+  uint32_t elapsed;
+  uint8_t phase;
+  bool merged; // 같은 구간 안에서 다시 열린 경우 바깥 구간에 합침
+
+  explicit PhaseScope(uint8_t p) : parent(active), elapsed(0), phase(p) {
+    merged = parent && parent->phase == p;
+    if (merged)
+      return;
+    start = phaseClock();
+    if (parent)
+      parent->elapsed += start - parent->start;
+    active = this;
+  }
+
+  ~PhaseScope() {
+    if (merged)
+      return;
+    uint32_t now = phaseClock();
+    phaseRecord(phase, elapsed + (now - start));
+    active = parent;
+    if (parent)
+      parent->start = now;
+  }
+};
+
+PhaseScope *PhaseScope::active = 0;
+
+void serialPrintPhaseStats() {
+  static const char *names[PHASE_COUNT] = {"algo", "render", "io"};
+  for (uint8_t p = 0; p < PHASE_COUNT; p++) {
+    Serial.print(F("PHASE:"));
+    Serial.print(names[p]);
+    Serial.print(F(" n="));
+    Serial.print((unsigned long)phaseHist[p].count);
+    Serial.print(F(" min="));
+    Serial.print((unsigned long)phaseHist[p].minValue);
+    Serial.print(F(" p50="));
+    Serial.print((unsigned long)phaseQuantile(p, 500));
+    Serial.print(F(" p99="));
+    Serial.print((unsigned long)phaseQuantile(p, 990));
+    Serial.print(F(" max="));
+    Serial.print((unsigned long)phaseHist[p].maxValue);
+    Serial.println(F(" " PHASE_UNIT));
+  }
+}
+
+// 실행 시작마다 호출: 보고가 그 실행의 구간만 담도록 히스토그램을 비움
+void phaseReset() {
+  for (uint8_t p = 0; p < PHASE_COUNT; p++)
+    phaseHist[p] = PhaseHistogram();
+}
+
+#define PHASE_SCOPE(p) PhaseScope phaseScope(p)
+#define PHASE_REPORT() serialPrintPhaseStats()
+#define PHASE_RESET() phaseReset()
+#else
+#define PHASE_SCOPE(p)
+#define PHASE_REPORT()
+#define PHASE_RESET()
+#endif
+
 void printHex(uint8_t value) {
   if (value < 16) Serial.print("0");
   Serial.print(value, HEX);
@@ -175,6 +366,7 @@ void serialPrintBrightnessChange() {
 }
 
 void serialPrintFrame() {
+  PHASE_SCOPE(PHASE_IO);
   #if USE_SERIAL
     Serial.print(F("FRAME:"));
     Serial.println(currentFrameNumber);
@@ -235,6 +427,7 @@ void setPixel(int x, int y, uint8_t r, uint8_t g, uint8_t b) {
 }
 
 void displayShow() {
+  PHASE_SCOPE(PHASE_IO);
   serialPrintBrightnessChange();
 
   #if USE_LED
@@ -287,6 +480,7 @@ void drawSquare(int col, int row, uint8_t r, uint8_t g, uint8_t b) {
 
 // 퀸이 공격할 수 있는지 확인
 bool isUnderAttack(int testRow, int testCol) {
+  PHASE_SCOPE(PHASE_ALGO);
   for (int r = 0; r < testRow; r++) {
     int c = queens[r];
 
@@ -301,6 +495,7 @@ bool isUnderAttack(int testRow, int testCol) {
 
 // 전체 체스판 그리기
 void drawBoard(int currentRow, int tryCol, bool showAttack) {
+  PHASE_SCOPE(PHASE_RENDER);
   displayClear();
 
   for (int row = 0; row < N; row++) {
@@ -356,6 +551,7 @@ void drawBoard(int currentRow, int tryCol, bool showAttack) {
 
 // 해를 찾았을 때 강조 표시
 void showSolution() {
+  PHASE_SCOPE(PHASE_RENDER);
   displayClear();
 
   for (int row = 0; row < N; row++) {
@@ -494,6 +690,7 @@ void loop() {
     Serial.read();
   }
 
+  PHASE_RESET();
   Serial.println(F("Starting 8-Queens solver..."));
 
   // 빈 보드 표시
@@ -509,6 +706,10 @@ void loop() {
   Serial.println(solutionCount);
   Serial.print(F("Total backtracks: "));
   Serial.println(backtrackCount);
+#ifdef TARGET_PC
+  strip.printTransferStats();
+#endif
+  PHASE_REPORT();
 
   displayDelay(5000);
 
@@ -0,0 +1,311 @@
+// Union-Find (Disjoint Set) - Arduino / PC 공용
+// - find: 반복 + 경로 반감 (재귀 없음, 스택 사용량 일정)
+// - unite: union by size (트리 높이 O(log n))
+// - 용량: realloc으로 늘어남 (add()는 필요할 때 2배씩)
+// - RollbackDisjointSet: 경로 압축 없이 union by rank + 합치기 기록
+//   마지막 합치기 되돌리기 O(1) (Kruskal 시각화의 되감기)
+// - ConcurrentDisjointSet (PC 전용): parent 링크를 CAS로 갱신하는 lock-free 버전
+//
+// Index는 원소 번호 타입. AVR 데모(노드 255개 이하)는 uint8_t로 SRAM 절약
+
+#ifndef DISJOINT_SET_H
+#define DISJOINT_SET_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+// ============================================================================
+// 1. DisjointSet (단일 스레드)
+// ============================================================================
+
+template <typename Index> class DisjointSet {
+public:
+  DisjointSet() : parent_(0), size_(0), count_(0), capacity_(0), sets_(0) {}
+  explicit DisjointSet(Index n)
+      : parent_(0), size_(0), count_(0), capacity_(0), sets_(0) {
+    resize(n);
+  }
+  ~DisjointSet() {
+    free(parent_);
+    free(size_);
+  }
+
+  // 용량 확보 (원소 수는 그대로). 메모리 부족이면 false
+  bool reserve(Index n) {
+    if (n <= capacity_)
+      return true;
+    Index *p = (Index *)realloc(parent_, (size_t)n * sizeof(Index));
+    if (!p)
+      return false;
+    parent_ = p;
+    Index *s = (Index *)realloc(size_, (size_t)n * sizeof(Index));
+    if (!s)
+      return false;
+    size_ = s;
+    capacity_ = n;
+    return true;
+  }
+
+  // 원소 n개를 모두 단일 집합으로 초기화 (makeSet x n)
+  bool resize(Index n) {
+    if (!reserve(n))
+      return false;
+    for (Index i = 0; i < n; i++) {
+      parent_[i] = i;
+      size_[i] = 1;
+    }
+    count_ = n;
+    sets_ = n;
+    return true;
+  }
+
+  // 새 단일 집합 하나 추가, 번호 반환. 용량을 늘릴 수 없으면 count()를 반환
+  Index add() {
+    if (count_ == capacity_) {
+      Index grown = capacity_ ? (Index)(capacity_ * 2) : (Index)8;
+      if (grown <= capacity_) // Index 범위 끝
+        grown = (Index)~(Index)0;
+      if (grown == capacity_ || !reserve(grown))
+        return count_;
+    }
+    Index x = count_++;
+    parent_[x] = x;
+    size_[x] = 1;
+    sets_++;
+    return x;
+  }
+
+  Index find(Index x) {
+    while (parent_[x] != x) {
+      parent_[x] = parent_[parent_[x]]; // 경로 반감
+      x = parent_[x];
+    }
+    return x;
+  }
+
+  // 경로를 고치지 않는 find (읽기 전용, 여러 스레드가 동시에 호출 가능)
+  Index root(Index x) const {
+    while (parent_[x] != x)
+      x = parent_[x];
+    return x;
+  }
+
+  // 합쳐졌으면 true, 이미 같은 집합(사이클)이면 false
+  bool unite(Index a, Index b) {
+    a = find(a);
+    b = find(b);
+    if (a == b)
+      return false;
+    if (size_[a] < size_[b]) {
+      Index t = a;
+      a = b;
+      b = t;
+    }
+    parent_[b] = a;
+    size_[a] += size_[b];
+    sets_--;
+    return true;
+  }
+
+  bool same(Index a, Index b) { return find(a) == find(b); }
+  Index setSize(Index x) { return size_[find(x)]; }
+  Index count() const { return count_; }
+  Index sets() const { return sets_; }
+
+private:
+  DisjointSet(const DisjointSet &);
+  DisjointSet &operator=(const DisjointSet &);
+
+  Index *parent_;
+  Index *size_;
+  Index count_;
+  Index capacity_;
+  Index sets_; // 현재 집합 수
+};
+
+// ============================================================================
+// 2. RollbackDisjointSet (되돌리기 가능)
+// ============================================================================
+// find()가 parent를 고치지 않으므로 합치기 하나가 바꾸는 것은
+// "자식 루트의 parent"와 "새 루트의 rank(같았으면 +1)"뿐 -> 기록해 두면 O(1)로 되돌림
+// union by rank라 트리 높이 <= log2(n), find O(log n)
+// 기록은 성공한 합치기만 (최대 n-1개), 거부된(사이클) 간선은 되돌릴 것이 없음
+
+template <typename Index> class RollbackDisjointSet {
+public:
+  RollbackDisjointSet()
+      : parent_(0), rank_(0), log_(0), bumped_(0), count_(0), capacity_(0),
+        history_(0) {}
+  explicit RollbackDisjointSet(Index n)
+      : parent_(0), rank_(0), log_(0), bumped_(0), count_(0), capacity_(0),
+        history_(0) {
+    resize(n);
+  }
+  ~RollbackDisjointSet() {
+    free(parent_);
+    free(rank_);
+    free(log_);
+    free(bumped_);
+  }
+
+  // 원소 n개를 모두 단일 집합으로, 기록은 비움. 메모리 부족이면 false
+  bool resize(Index n) {
+    if (n > capacity_) {
+      Index *p = (Index *)realloc(parent_, (size_t)n * sizeof(Index));
+      if (!p)
+        return false;
+      parent_ = p;
+      uint8_t *r = (uint8_t *)realloc(rank_, n);
+      if (!r)
+        return false;
+      rank_ = r;
+      Index *l = (Index *)realloc(log_, (size_t)n * sizeof(Index));
+      if (!l)
+        return false;
+      log_ = l;
+      uint8_t *b = (uint8_t *)realloc(bumped_, n);
+      if (!b)
+        return false;
+      bumped_ = b;
+      capacity_ = n;
+    }
+    for (Index i = 0; i < n; i++) {
+      parent_[i] = i;
+      rank_[i] = 0;
+    }
+    count_ = n;
+    history_ = 0;
+    return true;
+  }
+
+  Index find(Index x) const {
+    while (parent_[x] != x)
+      x = parent_[x];
+    return x;
+  }
+
+  // 합쳐졌으면 true (기록됨), 이미 같은 집합(사이클)이면 false
+  bool unite(Index a, Index b) {
+    a = find(a);
+    b = find(b);
+    if (a == b)
+      return false;
+    if (rank_[a] < rank_[b]) {
+      Index t = a;
+      a = b;
+      b = t;
+    }
+    parent_[b] = a;
+    bumped_[history_] = rank_[a] == rank_[b];
+    rank_[a] += bumped_[history_];
+    log_[history_++] = b;
+    return true;
+  }
+
+  // 마지막 합치기를 되돌림. 기록이 없으면 false
+  bool undo() {
+    if (history_ == 0)
+      return false;
+    Index b = log_[--history_];
+    rank_[parent_[b]] -= bumped_[history_];
+    parent_[b] = b;
+    return true;
+  }
+
+  // 기록이 to개 남을 때까지 되돌림
+  void rollback(Index to) {
+    while (history_ > to)
+      undo();
+  }
+
+  bool same(Index a, Index b) const { return find(a) == find(b); }
+  Index count() const { return count_; }
+  Index history() const { return history_; } // 지금까지 남은 합치기 수
+  Index sets() const { return count_ - history_; }
+
+private:
+  RollbackDisjointSet(const RollbackDisjointSet &);
+  RollbackDisjointSet &operator=(const RollbackDisjointSet &);
+
+  Index *parent_;
+  uint8_t *rank_;
+  Index *log_;      // i번째 합치기에서 다른 루트 밑으로 들어간 루트
+  uint8_t *bumped_; // 그때 새 루트의 rank가 올랐는지
+  Index count_;
+  Index capacity_;
+  Index history_;
+};
+
+// ============================================================================
+// 3. ConcurrentDisjointSet (PC 전용, lock-free)
+// ============================================================================
+// - find: 경로 반감을 CAS로 (실패해도 다른 스레드가 더 줄였으므로 무시)
+// - unite: 번호가 큰 루트를 작은 루트 밑에 CAS로 연결
+//   (parent 번호가 루트 쪽으로 항상 줄어들어 사이클이 생기지 않음)
+//   루트가 그 사이 바뀌었으면 CAS가 실패하고 다시 시도
+// find/same/unite를 여러 스레드에서 섞어 호출해도 안전
+
+#ifdef TARGET_PC
+#include <atomic>
+#include <memory>
+
+template <typename Index> class ConcurrentDisjointSet {
+public:
+  explicit ConcurrentDisjointSet(Index n)
+      : parent_(new std::atomic<Index>[n]), count_(n) {
+    for (Index i = 0; i < n; i++)
+      parent_[i].store(i, std::memory_order_relaxed);
+  }
+
+  Index find(Index x) {
+    while (true) {
+      Index p = parent_[x].load(std::memory_order_acquire);
+      if (p == x)
+        return x;
+      Index gp = parent_[p].load(std::memory_order_acquire);
+      if (p != gp)
+        parent_[x].compare_exchange_weak(p, gp, std::memory_order_release,
+                                         std::memory_order_relaxed);
+      x = gp;
+    }
+  }
+
+  bool same(Index a, Index b) {
+    while (true) {
+      a = find(a);
+      b = find(b);
+      if (a == b)
+        return true;
+      // a가 아직 루트라면 그 시점에 두 원소는 다른 집합
+      if (parent_[a].load(std::memory_order_acquire) == a)
+        return false;
+    }
+  }
+
+  bool unite(Index a, Index b) {
+    while (true) {
+      a = find(a);
+      b = find(b);
+      if (a == b)
+        return false;
+      if (a < b) {
+        Index t = a;
+        a = b;
+        b = t;
+      }
+      Index expected = a;
+      if (parent_[a].compare_exchange_strong(expected, b,
+                                             std::memory_order_acq_rel))
+        return true;
+    }
+  }
+
+  Index count() const { return count_; }
+
+private:
+  std::unique_ptr<std::atomic<Index>[]> parent_;
+  Index count_;
+};
+#endif
+
+#endif
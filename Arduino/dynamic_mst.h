@@ -0,0 +1,412 @@
+// 동적 MST (간선 추가/삭제) - PC 전용
+// 간선이 바뀔 때마다 Kruskal을 처음부터 다시 돌리지 않고 현재 신장 숲만 고침
+// - 추가: link-cut tree로 u-v 트리 경로의 최대 간선을 O(log n)에 찾아 교체
+// - 삭제: 트리 간선이면 자른 뒤, 양 끝점에서 트리 간선을 따라 번갈아 BFS해서
+//         먼저 끝나는 (작은) 쪽만 훑고, 그 쪽 정점의 비트리 간선 중 반대쪽으로
+//         나가는 가장 가벼운 간선으로 다시 이음. 비용은 작은 쪽의 차수 합
+//         (잎이나 작은 부분트리가 잘리는 흔한 경우에 전체 크기와 무관)
+// graph_kruskal.cpp의 --live 모드와 같은 규칙이며, 큰 그래프용
+
+#ifndef DYNAMIC_MST_H
+#define DYNAMIC_MST_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// 1. Link-cut tree (경로 최댓값)
+// ============================================================================
+// 정점과 간선을 모두 노드로 둠: 간선 e = (u, v)는 u - e - v로 연결
+// 정점 노드의 값은 INT32_MIN이라 경로 최댓값은 항상 간선 노드
+
+#define LCT_NIL UINT32_MAX
+
+class LinkCutTree {
+public:
+  void resize(size_t n) {
+    size_t old = nodes_.size();
+    nodes_.resize(n);
+    for (size_t i = old; i < n; i++)
+      reset((uint32_t)i, INT32_MIN);
+  }
+
+  void reset(uint32_t x, int32_t value) {
+    Node &a = nodes_[x];
+    a.child[0] = a.child[1] = a.parent = LCT_NIL;
+    a.value = value;
+    a.maxNode = x;
+    a.flip = false;
+  }
+
+  void link(uint32_t x, uint32_t y) {
+    makeRoot(x);
+    nodes_[x].parent = y;
+  }
+
+  // x - y가 직접 연결되어 있어야 함
+  void cut(uint32_t x, uint32_t y) {
+    makeRoot(x);
+    access(y);
+    // 이제 x는 y의 왼쪽 자식 (경로가 x, y 두 노드뿐)
+    nodes_[y].child[0] = LCT_NIL;
+    nodes_[x].parent = LCT_NIL;
+    pull(y);
+  }
+
+  bool connected(uint32_t x, uint32_t y) { return findRoot(x) == findRoot(y); }
+
+  // x-y 경로에서 값이 가장 큰 노드 (연결되어 있어야 함)
+  uint32_t pathMax(uint32_t x, uint32_t y) {
+    makeRoot(x);
+    access(y);
+    return nodes_[y].maxNode;
+  }
+
+private:
+  struct Node {
+    uint32_t child[2];
+    uint32_t parent;
+    int32_t value;
+    uint32_t maxNode; // splay 부분트리에서 값이 가장 큰 노드
+    bool flip;        // 좌우 뒤집기 지연 표시 (makeRoot)
+  };
+
+  bool isSplayRoot(uint32_t x) const {
+    uint32_t p = nodes_[x].parent;
+    return p == LCT_NIL ||
+           (nodes_[p].child[0] != x && nodes_[p].child[1] != x);
+  }
+
+  void pull(uint32_t x) {
+    Node &a = nodes_[x];
+    a.maxNode = x;
+    for (int d = 0; d < 2; d++) {
+      uint32_t c = a.child[d];
+      if (c != LCT_NIL &&
+          nodes_[nodes_[c].maxNode].value > nodes_[a.maxNode].value)
+        a.maxNode = nodes_[c].maxNode;
+    }
+  }
+
+  void push(uint32_t x) {
+    Node &a = nodes_[x];
+    if (!a.flip)
+      return;
+    std::swap(a.child[0], a.child[1]);
+    for (int d = 0; d < 2; d++) {
+      if (a.child[d] != LCT_NIL)
+        nodes_[a.child[d]].flip = !nodes_[a.child[d]].flip;
+    }
+    a.flip = false;
+  }
+
+  void rotate(uint32_t x) {
+    uint32_t y = nodes_[x].parent;
+    uint32_t z = nodes_[y].parent;
+    int d = nodes_[y].child[1] == x;
+    if (!isSplayRoot(y))
+      nodes_[z].child[nodes_[z].child[1] == y] = x;
+    nodes_[x].parent = z;
+    uint32_t moved = nodes_[x].child[d ^ 1];
+    nodes_[y].child[d] = moved;
+    if (moved != LCT_NIL)
+      nodes_[moved].parent = y;
+    nodes_[x].child[d ^ 1] = y;
+    nodes_[y].parent = x;
+    pull(y);
+    pull(x);
+  }
+
+  void splay(uint32_t x) {
+    // 위에서부터 지연 표시를 내림
+    stack_.clear();
+    uint32_t y = x;
+    stack_.push_back(y);
+    while (!isSplayRoot(y)) {
+      y = nodes_[y].parent;
+      stack_.push_back(y);
+    }
+    for (size_t i = stack_.size(); i-- > 0;)
+      push(stack_[i]);
+
+    while (!isSplayRoot(x)) {
+      uint32_t p = nodes_[x].parent;
+      if (!isSplayRoot(p)) {
+        uint32_t g = nodes_[p].parent;
+        bool zigzig = (nodes_[g].child[1] == p) == (nodes_[p].child[1] == x);
+        rotate(zigzig ? p : x);
+      }
+      rotate(x);
+    }
+  }
+
+  void access(uint32_t x) {
+    uint32_t last = LCT_NIL;
+    for (uint32_t y = x; y != LCT_NIL; y = nodes_[y].parent) {
+      splay(y);
+      nodes_[y].child[1] = last;
+      pull(y);
+      last = y;
+    }
+    splay(x);
+  }
+
+  void makeRoot(uint32_t x) {
+    access(x);
+    nodes_[x].flip = !nodes_[x].flip;
+  }
+
+  uint32_t findRoot(uint32_t x) {
+    access(x);
+    push(x);
+    while (nodes_[x].child[0] != LCT_NIL) {
+      x = nodes_[x].child[0];
+      push(x);
+    }
+    splay(x);
+    return x;
+  }
+
+  std::vector<Node> nodes_;
+  std::vector<uint32_t> stack_;
+};
+
+// ============================================================================
+// 2. 동적 MST
+// ============================================================================
+
+#define DYNAMIC_MST_NONE UINT32_MAX
+
+// 한 번의 변경으로 트리에 들어오고 나간 간선 (시각화는 이 둘만 다시 그림)
+struct MstChange {
+  uint32_t added = DYNAMIC_MST_NONE;
+  uint32_t removed = DYNAMIC_MST_NONE;
+};
+
+class DynamicMst {
+public:
+  explicit DynamicMst(uint32_t nodeCount)
+      : nodeCount_(nodeCount), incident_(nodeCount), mark_(nodeCount, 0) {
+    tree_.resize(nodeCount);
+  }
+
+  // 간선 추가, 간선 번호 반환 (삭제된 번호는 재사용)
+  uint32_t insert(uint32_t u, uint32_t v, int32_t w,
+                  MstChange *change = nullptr) {
+    uint32_t id = allocate(u, v, w);
+    MstChange c;
+    if (u != v && !tree_.connected(u, v)) {
+      linkEdge(id);
+      c.added = id;
+    } else if (u != v) {
+      uint32_t heaviest = tree_.pathMax(u, v) - nodeCount_;
+      if (edges_[heaviest].w > w) {
+        cutEdge(heaviest);
+        linkEdge(id);
+        c.added = id;
+        c.removed = heaviest;
+      }
+    } // 자기 루프는 트리에 들어가지 않음
+    if (change)
+      *change = c;
+    return id;
+  }
+
+  // 이미 삭제했거나 없는 번호면 아무것도 하지 않고 false
+  bool erase(uint32_t id, MstChange *change = nullptr) {
+    MstChange c;
+    if (change)
+      *change = c;
+    if (id >= edges_.size() || !edges_[id].live)
+      return false;
+    detach(id);
+    if (edges_[id].inTree) {
+      cutEdge(id);
+      c.removed = id;
+      uint32_t replacement = findReplacement(edges_[id].u, edges_[id].v);
+      if (replacement != DYNAMIC_MST_NONE) {
+        linkEdge(replacement);
+        c.added = replacement;
+      }
+    }
+    edges_[id].live = false;
+    freeIds_.push_back(id);
+    if (change)
+      *change = c;
+    return true;
+  }
+
+  int64_t weight() const { return weight_; }
+  uint32_t treeEdges() const { return treeEdges_; }
+  uint32_t nodeCount() const { return nodeCount_; }
+  uint64_t replacementScans() const { return scans_; } // 삭제 시 훑은 인접 간선 수
+  bool inTree(uint32_t id) const { return edges_[id].inTree; }
+  bool live(uint32_t id) const { return edges_[id].live; }
+  size_t idLimit() const { return edges_.size(); }
+  uint32_t edgeU(uint32_t id) const { return edges_[id].u; }
+  uint32_t edgeV(uint32_t id) const { return edges_[id].v; }
+  int32_t edgeWeight(uint32_t id) const { return edges_[id].w; }
+
+private:
+  struct Edge {
+    uint32_t u, v;
+    uint32_t posU, posV; // incident_[u], incident_[v] 안의 위치
+    int32_t w;
+    bool inTree;
+    bool live;
+  };
+
+  // BFS 한쪽의 진행 상태 (queue의 head번 정점의 cursor번째 인접 간선부터)
+  struct Side {
+    std::vector<uint32_t> *queue;
+    size_t head;
+    size_t cursor;
+    uint32_t stamp;
+  };
+
+  uint32_t other(uint32_t id, uint32_t x) const {
+    return edges_[id].u == x ? edges_[id].v : edges_[id].u;
+  }
+
+  void attach(uint32_t id) {
+    Edge &e = edges_[id];
+    e.posU = (uint32_t)incident_[e.u].size();
+    incident_[e.u].push_back(id);
+    if (e.v != e.u) {
+      e.posV = (uint32_t)incident_[e.v].size();
+      incident_[e.v].push_back(id);
+    }
+  }
+
+  void removeIncident(uint32_t x, uint32_t pos) {
+    std::vector<uint32_t> &list = incident_[x];
+    uint32_t last = list.back();
+    if (pos + 1 != list.size()) {
+      Edge &l = edges_[last];
+      if (l.u == x && l.posU == list.size() - 1)
+        l.posU = pos;
+      else
+        l.posV = pos;
+      list[pos] = last;
+    }
+    list.pop_back();
+  }
+
+  void detach(uint32_t id) {
+    Edge &e = edges_[id];
+    removeIncident(e.u, e.posU);
+    if (e.v != e.u)
+      removeIncident(e.v, e.posV);
+  }
+
+  // 인접 간선 하나만 진행. 이쪽 BFS가 끝났으면 false
+  bool step(Side &s) {
+    while (s.head < s.queue->size()) {
+      uint32_t x = (*s.queue)[s.head];
+      if (s.cursor < incident_[x].size()) {
+        uint32_t id = incident_[x][s.cursor++];
+        scans_++;
+        if (edges_[id].inTree) {
+          uint32_t y = other(id, x);
+          if (mark_[y] != s.stamp) {
+            mark_[y] = s.stamp;
+            s.queue->push_back(y);
+          }
+        }
+        return true;
+      }
+      s.head++;
+      s.cursor = 0;
+    }
+    return false;
+  }
+
+  // 잘린 두 트리(u쪽, v쪽)를 잇는 가장 가벼운 비트리 간선
+  uint32_t findReplacement(uint32_t u, uint32_t v) {
+    epoch_ += 2;
+    queueA_.assign(1, u);
+    queueB_.assign(1, v);
+    Side a = {&queueA_, 0, 0, epoch_ - 1};
+    Side b = {&queueB_, 0, 0, epoch_};
+    mark_[u] = a.stamp;
+    mark_[v] = b.stamp;
+    Side *small = nullptr;
+    while (!small) {
+      if (!step(a))
+        small = &a;
+      else if (!step(b))
+        small = &b;
+    }
+
+    // 비트리 간선의 끝점은 자르기 전에 연결되어 있었으므로
+    // 작은 쪽 밖으로 나가는 간선은 모두 반대쪽 트리로 감
+    uint32_t best = DYNAMIC_MST_NONE;
+    for (size_t i = 0; i < small->queue->size(); i++) {
+      uint32_t x = (*small->queue)[i];
+      for (size_t k = 0; k < incident_[x].size(); k++) {
+        uint32_t id = incident_[x][k];
+        scans_++;
+        if (edges_[id].inTree || mark_[other(id, x)] == small->stamp)
+          continue;
+        if (best == DYNAMIC_MST_NONE || edges_[id].w < edges_[best].w ||
+            (edges_[id].w == edges_[best].w && id < best))
+          best = id;
+      }
+    }
+    return best;
+  }
+
+  uint32_t allocate(uint32_t u, uint32_t v, int32_t w) {
+    uint32_t id;
+    if (!freeIds_.empty()) {
+      id = freeIds_.back();
+      freeIds_.pop_back();
+    } else {
+      id = (uint32_t)edges_.size();
+      edges_.push_back(Edge());
+      tree_.resize(nodeCount_ + edges_.size());
+    }
+    Edge &e = edges_[id];
+    e.u = u;
+    e.v = v;
+    e.w = w;
+    e.inTree = false;
+    e.live = true;
+    tree_.reset(nodeCount_ + id, w);
+    attach(id);
+    return id;
+  }
+
+  void linkEdge(uint32_t id) {
+    Edge &e = edges_[id];
+    tree_.link(e.u, nodeCount_ + id);
+    tree_.link(nodeCount_ + id, e.v);
+    e.inTree = true;
+    weight_ += e.w;
+    treeEdges_++;
+  }
+
+  void cutEdge(uint32_t id) {
+    Edge &e = edges_[id];
+    tree_.cut(e.u, nodeCount_ + id);
+    tree_.cut(nodeCount_ + id, e.v);
+    e.inTree = false;
+    weight_ -= e.w;
+    treeEdges_--;
+  }
+
+  uint32_t nodeCount_;
+  LinkCutTree tree_;
+  std::vector<Edge> edges_;
+  std::vector<uint32_t> freeIds_;
+  std::vector<std::vector<uint32_t>> incident_; // 정점별 간선 번호 (트리+비트리)
+  std::vector<uint32_t> mark_;                  // BFS 방문 표시 (epoch_ 기준)
+  std::vector<uint32_t> queueA_, queueB_;
+  uint32_t epoch_ = 0;
+  int64_t weight_ = 0;
+  uint32_t treeEdges_ = 0;
+  uint64_t scans_ = 0;
+};
+
+#endif
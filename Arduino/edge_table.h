@@ -0,0 +1,92 @@
+// 간선 표 (Structure-of-Arrays) - Arduino / PC 공용
+// 스케치의 고정 크기 간선 배열. {int u, v, weight} 구조체 배열 대신 열 3개
+// - Node, Weight: 정수 폭을 컴파일 시 선택 (데모 그래프는 uint8_t -> 간선당 3바이트,
+//   AVR에서 구조체 배열의 6바이트 대비 절반)
+// - 정렬: 간선 번호만 옮기는 안정 삽입 정렬 뒤 열마다 한 번씩 재배치
+//   (graph_edges.h의 radixSortPermutation() + applyPermutation()과 같은 방식)
+// - 초기 표는 {u, v, w} 바이트 행으로 플래시(PROGMEM)에 두고 생성자에서 옮김
+// 큰 그래프(PC 헤드리스)는 graph_edges.h의 EdgeList (uint32_t / int32_t 열)
+
+#ifndef EDGE_TABLE_H
+#define EDGE_TABLE_H
+
+#include <stdint.h>
+
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#define EDGE_ROW_READ(p) pgm_read_byte(p)
+#else
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#define EDGE_ROW_READ(p) (*(const uint8_t *)(p))
+#endif
+
+template <typename Node, typename Weight, int Capacity> class EdgeTable {
+public:
+  Node u[Capacity];
+  Node v[Capacity];
+  Weight w[Capacity];
+
+  EdgeTable() {}
+
+  // 플래시의 {u, v, w} 행 count개로 채움
+  EdgeTable(const uint8_t (*rows)[3], int count) {
+    for (int i = 0; i < count && i < Capacity; i++) {
+      u[i] = (Node)EDGE_ROW_READ(&rows[i][0]);
+      v[i] = (Node)EDGE_ROW_READ(&rows[i][1]);
+      w[i] = (Weight)EDGE_ROW_READ(&rows[i][2]);
+    }
+  }
+
+  void set(int i, Node a, Node b, Weight weight) {
+    u[i] = a;
+    v[i] = b;
+    w[i] = weight;
+  }
+
+  void copy(int to, int from) {
+    u[to] = u[from];
+    v[to] = v[from];
+    w[to] = w[from];
+  }
+
+  // 값이 Weight에 그대로 들어가는지 (실시간 입력 검사용)
+  static bool weightFits(long weight) { return (long)(Weight)weight == weight; }
+
+  // 가중치 오름차순 간선 번호 (같은 가중치는 원래 순서). 간선 자체는 그대로
+  void weightOrder(uint16_t *order, int count) const {
+    for (int i = 0; i < count; i++) {
+      int j = i - 1;
+      while (j >= 0 && w[order[j]] > w[i]) {
+        order[j + 1] = order[j];
+        j--;
+      }
+      order[j + 1] = (uint16_t)i;
+    }
+  }
+
+  // 가중치 순으로 제자리 재배치: 번호만 정렬한 뒤 순열의 사이클을 따라 한 칸씩 옮김
+  // (임시 행 하나 + 번호 배열만 사용)
+  void sortByWeight(int count) {
+    uint16_t order[Capacity];
+    weightOrder(order, count);
+    for (int start = 0; start < count; start++) {
+      if (order[start] == start)
+        continue;
+      Node su = u[start], sv = v[start];
+      Weight sw = w[start];
+      int i = start;
+      while (order[i] != start) {
+        int from = order[i];
+        copy(i, from);
+        order[i] = (uint16_t)i;
+        i = from;
+      }
+      set(i, su, sv, sw);
+      order[i] = (uint16_t)i;
+    }
+  }
+};
+
+#endif
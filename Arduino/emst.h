@@ -0,0 +1,415 @@
+// 유클리드 MST (좌표에서 바로) - PC 전용
+// k-d 트리 위의 Borůvka:
+//   라운드마다 모든 점이 "다른 컴포넌트에 속한 가장 가까운 점"을 찾고
+//   (같은 컴포넌트뿐인 부분트리와 현재 최선보다 먼 상자는 건너뜀)
+//   컴포넌트별 최소 간선으로 합침. 라운드 수 O(log n)
+// 찾은 간선들(후보 그래프, EMST를 반드시 포함)을 kruskalMST()에 넣어 트리를 얻음
+// 거리는 정수 좌표의 제곱거리 (정확), 리프의 거리 계산은 SIMD 벡터로
+
+#ifndef EMST_H
+#define EMST_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "disjoint_set.h"
+#include "edge_table.h"
+#include "graph_csr.h"
+#include "graph_edges.h"
+#include "mst_engines.h"
+
+#define EMST_MAX_COORD 32767 // 0..32767이면 제곱거리가 int32에 들어감
+#define EMST_LEAF_SIZE 16
+
+struct PointSet {
+  std::vector<int32_t> x;
+  std::vector<int32_t> y;
+
+  size_t size() const { return x.size(); }
+  void add(int32_t px, int32_t py) {
+    x.push_back(px);
+    y.push_back(py);
+  }
+};
+
+// ============================================================================
+// 1. 제곱거리 (SIMD)
+// ============================================================================
+// GCC 벡터 확장: 대상 CPU의 SIMD 폭에 맞게 나뉘어 컴파일됨 (SSE2/AVX2/NEON)
+
+#if defined(__GNUC__)
+#define EMST_LANES 8
+typedef int32_t EmstLanes __attribute__((vector_size(EMST_LANES * 4)));
+#endif
+
+inline void squaredDistances(const int32_t *xs, const int32_t *ys, size_t n,
+                             int32_t qx, int32_t qy, int32_t *out) {
+  size_t i = 0;
+#ifdef EMST_LANES
+  for (; i + EMST_LANES <= n; i += EMST_LANES) {
+    EmstLanes dx, dy;
+    std::memcpy(&dx, xs + i, sizeof(dx));
+    std::memcpy(&dy, ys + i, sizeof(dy));
+    dx -= qx;
+    dy -= qy;
+    dx = dx * dx + dy * dy;
+    std::memcpy(out + i, &dx, sizeof(dx));
+  }
+#endif
+  for (; i < n; i++) {
+    int32_t dx = xs[i] - qx, dy = ys[i] - qy;
+    out[i] = dx * dx + dy * dy;
+  }
+}
+
+// ============================================================================
+// 2. k-d 트리
+// ============================================================================
+// 점을 트리 순서로 재배치 (px/py/pid). 노드는 전위 순서라 부모 번호 < 자식 번호
+
+#define EMST_MIXED UINT32_MAX
+
+struct EmstNode {
+  int32_t minX, minY, maxX, maxY;
+  uint32_t begin, end;
+  uint32_t left, right; // 리프면 0
+  uint32_t comp;        // 부분트리 점이 모두 같은 컴포넌트면 그 번호, 아니면 MIXED
+};
+
+struct EmstTree {
+  std::vector<int32_t> px, py;
+  std::vector<uint32_t> pid; // 재배치된 위치 -> 원래 점 번호
+  std::vector<EmstNode> nodes;
+
+  void build(const PointSet &pts) {
+    const size_t n = pts.size();
+    pid.resize(n);
+    for (size_t i = 0; i < n; i++)
+      pid[i] = (uint32_t)i;
+    nodes.clear();
+    nodes.reserve(2 * (n / EMST_LEAF_SIZE + 1));
+    if (n)
+      buildNode(pts, 0, (uint32_t)n);
+    px.resize(n);
+    py.resize(n);
+    for (size_t i = 0; i < n; i++) {
+      px[i] = pts.x[pid[i]];
+      py[i] = pts.y[pid[i]];
+    }
+  }
+
+  // 점 p와 상자 사이 최소 제곱거리
+  static int64_t boxDistance(const EmstNode &b, int32_t x, int32_t y) {
+    int64_t dx = x < b.minX ? b.minX - x : (x > b.maxX ? x - b.maxX : 0);
+    int64_t dy = y < b.minY ? b.minY - y : (y > b.maxY ? y - b.maxY : 0);
+    return dx * dx + dy * dy;
+  }
+
+private:
+  uint32_t buildNode(const PointSet &pts, uint32_t begin, uint32_t end) {
+    uint32_t id = (uint32_t)nodes.size();
+    nodes.push_back(EmstNode());
+    EmstNode b;
+    b.minX = b.minY = INT32_MAX;
+    b.maxX = b.maxY = INT32_MIN;
+    for (uint32_t i = begin; i < end; i++) {
+      int32_t x = pts.x[pid[i]], y = pts.y[pid[i]];
+      b.minX = std::min(b.minX, x);
+      b.maxX = std::max(b.maxX, x);
+      b.minY = std::min(b.minY, y);
+      b.maxY = std::max(b.maxY, y);
+    }
+    b.begin = begin;
+    b.end = end;
+    b.left = b.right = 0;
+    b.comp = EMST_MIXED;
+    if (end - begin > EMST_LEAF_SIZE) {
+      // 넓은 축의 중앙값으로 분할
+      const std::vector<int32_t> &axis =
+          (b.maxX - b.minX >= b.maxY - b.minY) ? pts.x : pts.y;
+      uint32_t mid = begin + (end - begin) / 2;
+      std::nth_element(pid.begin() + begin, pid.begin() + mid,
+                       pid.begin() + end, [&axis](uint32_t a, uint32_t c) {
+                         return axis[a] < axis[c];
+                       });
+      b.left = buildNode(pts, begin, mid);
+      b.right = buildNode(pts, mid, end);
+    }
+    nodes[id] = b;
+    return id;
+  }
+};
+
+// ============================================================================
+// 3. Borůvka 라운드
+// ============================================================================
+
+// 간선 순서: 제곱거리, 같으면 (작은 점 번호, 큰 점 번호) -> 전순서라 사이클 없음
+struct EmstKey {
+  int64_t d2;
+  uint32_t lo, hi;
+
+  bool operator<(const EmstKey &o) const {
+    if (d2 != o.d2)
+      return d2 < o.d2;
+    if (lo != o.lo)
+      return lo < o.lo;
+    return hi < o.hi;
+  }
+};
+
+struct EmstStats {
+  uint32_t rounds = 0;
+  uint64_t distanceEvals = 0; // SIMD로 계산한 점-점 거리 수
+  double length = 0;          // 트리 간선 길이 합
+};
+
+class EmstBoruvka {
+public:
+  EmstBoruvka(const EmstTree &tree, EmstStats &stats)
+      : tree_(tree), stats_(stats), label_(tree.px.size()),
+        nodeComp_(tree.nodes.size()), scratch_(EMST_LEAF_SIZE) {}
+
+  // 라운드마다 찾은 간선을 candidates에 추가
+  void run(EdgeList &candidates) {
+    const uint32_t n = (uint32_t)tree_.px.size();
+    DisjointSet<uint32_t> sets(n);
+    std::vector<EmstKey> compBest(n);
+    std::vector<uint32_t> compA(n), compB(n);
+    const EmstKey none = {INT64_MAX, UINT32_MAX, UINT32_MAX};
+
+    while (sets.sets() > 1) {
+      stats_.rounds++;
+      for (uint32_t i = 0; i < n; i++)
+        label_[i] = sets.find(tree_.pid[i]);
+      labelNodes();
+      for (uint32_t i = 0; i < n; i++)
+        compBest[label_[i]] = none;
+
+      for (uint32_t q = 0; q < n; q++) {
+        uint32_t c = label_[q];
+        EmstKey best = compBest[c];
+        uint32_t found = nearestOutside(q, c, best);
+        if (found == UINT32_MAX)
+          continue;
+        compBest[c] = best;
+        compA[c] = tree_.pid[q];
+        compB[c] = tree_.pid[found];
+        candidates.add(tree_.pid[q], tree_.pid[found], (int32_t)best.d2);
+      }
+
+      for (uint32_t i = 0; i < n; i++) {
+        uint32_t c = label_[i];
+        if (tree_.pid[i] == c && compBest[c].d2 != INT64_MAX)
+          sets.unite(compA[c], compB[c]);
+      }
+    }
+  }
+
+private:
+  // 리프부터 올라가며 "한 컴포넌트뿐인 부분트리" 표시
+  void labelNodes() {
+    for (size_t k = tree_.nodes.size(); k-- > 0;) {
+      const EmstNode &b = tree_.nodes[k];
+      if (b.left) {
+        uint32_t l = nodeComp_[b.left], r = nodeComp_[b.right];
+        nodeComp_[k] = l == r ? l : EMST_MIXED;
+      } else {
+        uint32_t c = label_[b.begin];
+        for (uint32_t i = b.begin + 1; i < b.end && c != EMST_MIXED; i++) {
+          if (label_[i] != c)
+            c = EMST_MIXED;
+        }
+        nodeComp_[k] = c;
+      }
+    }
+  }
+
+  // q와 다른 컴포넌트의 점 중 best보다 가까운 점 (없으면 UINT32_MAX)
+  uint32_t nearestOutside(uint32_t q, uint32_t c, EmstKey &best) {
+    const int32_t qx = tree_.px[q], qy = tree_.py[q];
+    const uint32_t qid = tree_.pid[q];
+    uint32_t found = UINT32_MAX;
+    uint32_t stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+      const uint32_t k = stack[--top];
+      const EmstNode &b = tree_.nodes[k];
+      if (nodeComp_[k] == c || EmstTree::boxDistance(b, qx, qy) > best.d2)
+        continue;
+      if (b.left) {
+        // 가까운 자식을 나중에 넣어 먼저 방문
+        const EmstNode &l = tree_.nodes[b.left];
+        const EmstNode &r = tree_.nodes[b.right];
+        bool leftFirst =
+            EmstTree::boxDistance(l, qx, qy) <= EmstTree::boxDistance(r, qx, qy);
+        stack[top++] = leftFirst ? b.right : b.left;
+        stack[top++] = leftFirst ? b.left : b.right;
+        continue;
+      }
+      const uint32_t count = b.end - b.begin;
+      squaredDistances(&tree_.px[b.begin], &tree_.py[b.begin], count, qx, qy,
+                       scratch_.data());
+      stats_.distanceEvals += count;
+      for (uint32_t i = 0; i < count; i++) {
+        uint32_t p = b.begin + i;
+        if (label_[p] == c || scratch_[i] > best.d2)
+          continue;
+        uint32_t pid = tree_.pid[p];
+        EmstKey key = {scratch_[i], std::min(qid, pid), std::max(qid, pid)};
+        if (key < best) {
+          best = key;
+          found = p;
+        }
+      }
+    }
+    return found;
+  }
+
+  const EmstTree &tree_;
+  EmstStats &stats_;
+  std::vector<uint32_t> label_;    // 재배치된 점 -> 컴포넌트 대표 (원래 번호)
+  std::vector<uint32_t> nodeComp_; // 노드 -> 컴포넌트 또는 MIXED
+  std::vector<int32_t> scratch_;
+};
+
+// ============================================================================
+// 4. 진입점
+// ============================================================================
+
+// candidates: 후보 그래프 (가중치 = 제곱거리), tree: candidates 기준 MST
+// 좌표가 0..EMST_MAX_COORD 밖이면 false
+inline bool euclideanMST(const PointSet &pts, EdgeList &candidates,
+                         MstResult &tree, EmstStats &stats) {
+  for (size_t i = 0; i < pts.size(); i++) {
+    if (pts.x[i] < 0 || pts.x[i] > EMST_MAX_COORD || pts.y[i] < 0 ||
+        pts.y[i] > EMST_MAX_COORD) {
+      std::fprintf(stderr, "emst: point %zu out of range 0..%d\n", i,
+                   EMST_MAX_COORD);
+      return false;
+    }
+  }
+  EmstTree kd;
+  kd.build(pts);
+  candidates.clear();
+  candidates.nodeCount = (uint32_t)pts.size();
+  EmstBoruvka boruvka(kd, stats);
+  boruvka.run(candidates);
+
+  kruskalMST(candidates, tree);
+  stats.length = 0;
+  for (size_t i = 0; i < tree.edgeIds.size(); i++)
+    stats.length += std::sqrt((double)candidates.w[tree.edgeIds[i]]);
+  return true;
+}
+
+// ============================================================================
+// 5. 손으로 적은 가중치 표 검사
+// ============================================================================
+// 스케치의 nodes[] / edges[] 표가 좌표의 유클리드 거리(반올림)와 맞는지 확인
+// edgeAt(i, u, v, w)가 i번 간선을 꺼냄 (구조체 배열 / EdgeTable 열 모두). 틀린 간선 수 반환
+
+template <typename Node, typename EdgeAt>
+int checkWeightTableBy(const Node *nodes, int nodeCount, int edgeCount,
+                       EdgeAt edgeAt) {
+  int mismatches = 0;
+  for (int i = 0; i < edgeCount; i++) {
+    int u, v, weight;
+    edgeAt(i, u, v, weight);
+    if (u < 0 || u >= nodeCount || v < 0 || v >= nodeCount) {
+      std::printf("WEIGHT: edge %d (%d-%d) node out of range\n", i, u, v);
+      mismatches++;
+      continue;
+    }
+    double dx = nodes[u].x - nodes[v].x, dy = nodes[u].y - nodes[v].y;
+    double d = std::sqrt(dx * dx + dy * dy);
+    int expected = (int)std::lround(d);
+    if (expected != weight) {
+      std::printf("WEIGHT: edge %d (%d-%d) table=%d distance=%.2f expected=%d\n",
+                  i, u, v, weight, d, expected);
+      mismatches++;
+    }
+  }
+  std::printf("WEIGHT: checked=%d mismatches=%d\n", edgeCount, mismatches);
+  return mismatches;
+}
+
+// EdgeT는 u, v, weight 멤버를 가진 스케치 구조체
+template <typename Node, typename EdgeT>
+int checkWeightTable(const Node *nodes, int nodeCount, const EdgeT *edges,
+                     int edgeCount) {
+  return checkWeightTableBy(nodes, nodeCount, edgeCount,
+                            [edges](int i, int &u, int &v, int &w) {
+                              u = edges[i].u;
+                              v = edges[i].v;
+                              w = edges[i].weight;
+                            });
+}
+
+// EdgeTable (edge_table.h): u, v, w 열
+template <typename Node, typename NodeId, typename Weight, int Capacity>
+int checkWeightTable(const Node *nodes, int nodeCount,
+                     const EdgeTable<NodeId, Weight, Capacity> &edges,
+                     int edgeCount) {
+  return checkWeightTableBy(nodes, nodeCount, edgeCount,
+                            [&edges](int i, int &u, int &v, int &w) {
+                              u = edges.u[i];
+                              v = edges.v[i];
+                              w = (int)edges.w[i];
+                            });
+}
+
+// 스케치 좌표(또는 점 파일)로 EMST를 계산해 출력. listEdges면 트리 간선도 출력
+inline int printEuclideanMST(const PointSet &pts, bool listEdges) {
+  EdgeList candidates;
+  MstResult tree;
+  EmstStats stats;
+  if (!euclideanMST(pts, candidates, tree, stats))
+    return 1;
+  std::printf("EMST: points=%zu candidates=%zu rounds=%u tree_edges=%zu "
+              "length=%.2f dist_evals=%llu\n",
+              pts.size(), candidates.size(), stats.rounds,
+              tree.edgeIds.size(), stats.length,
+              (unsigned long long)stats.distanceEvals);
+  for (size_t i = 0; listEdges && i < tree.edgeIds.size(); i++) {
+    uint32_t id = tree.edgeIds[i];
+    std::printf("  %u-%u d=%.2f\n", candidates.u[id], candidates.v[id],
+                std::sqrt((double)candidates.w[id]));
+  }
+  return 0;
+}
+
+// "x y" 한 줄에 점 하나 ('#' 주석)
+inline bool loadPoints(const char *path, PointSet &pts) {
+  MappedFile f;
+  if (!f.open(path)) {
+    std::fprintf(stderr, "points: cannot open %s\n", path);
+    return false;
+  }
+  TextCursor c{f.data, f.data + f.size};
+  while (c.p < c.end) {
+    c.skipBlanks();
+    if (c.p < c.end && *c.p != '#' && *c.p != '\n') {
+      int64_t x, y;
+      if (!c.readInt(x) || !c.readInt(y)) {
+        std::fprintf(stderr, "points: parse error\n");
+        return false;
+      }
+      // int32_t로 줄이기 전에 검사 (넘치는 값이 범위 안의 작은 값으로 접히지 않게)
+      if (x < 0 || x > EMST_MAX_COORD || y < 0 || y > EMST_MAX_COORD) {
+        std::fprintf(stderr, "points: point %zu out of range 0..%d\n",
+                     pts.size(), EMST_MAX_COORD);
+        return false;
+      }
+      pts.add((int32_t)x, (int32_t)y);
+    }
+    c.skipLine();
+  }
+  return true;
+}
+
+#endif
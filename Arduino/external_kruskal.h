@@ -0,0 +1,417 @@
+// 외부 메모리 Kruskal - PC 전용
+// 간선이 메모리보다 많을 때:
+//   1) 입력을 메모리 예산만큼씩 읽어 가중치순으로 정렬한 런(run) 파일로 씀
+//   2) 런이 너무 많으면 (버퍼가 작아지면) 여러 번에 나눠 병합
+//   3) 마지막 병합 결과를 바로 DisjointSet에 흘려 보냄 (정렬된 전체 목록은 만들지 않음)
+//      트리가 완성되면(V-1개) 나머지 스트림은 읽지 않음
+// 상주 메모리: 런 버퍼(예산) + Union-Find O(V). 트리 간선은 파일로 바로 씀
+// 입력: 바이너리(.vag, 세 열을 따로 순차 읽기) 또는 DIMACS/SNAP 텍스트(한 줄씩)
+
+#ifndef EXTERNAL_KRUSKAL_H
+#define EXTERNAL_KRUSKAL_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "disjoint_set.h"
+#include "graph_csr.h"
+
+#define EXTERNAL_MIN_BUFFER (64 * 1024) // 병합할 때 런 하나에 줄 최소 버퍼 (바이트)
+#define EXTERNAL_STAGE 4096             // 바이너리 열을 한 번에 읽는 간선 수
+
+struct RunEdge {
+  int32_t w;
+  uint32_t u, v;
+};
+
+struct ExternalStats {
+  uint64_t edges = 0;
+  uint32_t nodeCount = 0;
+  uint32_t runs = 0;         // 처음 만든 런 수
+  uint32_t mergePasses = 0;  // 중간 병합 단계 수 (마지막 병합 제외)
+  uint64_t inputBytes = 0;   // 입력 파일에서 읽은 바이트
+  uint64_t runBytesRead = 0; // 런 파일에서 읽은 바이트
+  uint64_t runBytesWritten = 0;
+  uint64_t streamed = 0;     // 마지막 병합에서 Kruskal이 받은 간선 수
+  size_t bufferBytes = 0;    // 런 버퍼 크기
+  size_t unionFindBytes = 0;
+  int64_t weight = 0;
+  uint32_t treeEdges = 0;
+  double runMs = 0, mergeMs = 0;
+};
+
+// ============================================================================
+// 1. 입력 스트림
+// ============================================================================
+
+class EdgeStream {
+public:
+  ~EdgeStream() { close(); }
+
+  bool open(const char *path) {
+    text_ = std::fopen(path, "rb");
+    if (!text_) {
+      std::fprintf(stderr, "external: cannot open %s\n", path);
+      return false;
+    }
+    BinaryGraphHeader h;
+    if (std::fread(&h, sizeof(h), 1, text_) == 1 &&
+        std::memcmp(h.magic, BINARY_GRAPH_MAGIC, 8) == 0) {
+      // parseBinaryGraph()와 같은 검사: 곱하기 전에 파일 크기와 비교
+      std::fseek(text_, 0, SEEK_END);
+      const long fileSize = std::ftell(text_);
+      if (h.version != BINARY_GRAPH_VERSION || h.nodeCount > UINT32_MAX ||
+          fileSize < (long)sizeof(h) ||
+          h.edgeCount > ((uint64_t)fileSize - sizeof(h)) / (3 * sizeof(uint32_t))) {
+        std::fprintf(stderr, "external: bad header or truncated file\n");
+        return false;
+      }
+      binary_ = true;
+      remaining_ = h.edgeCount;
+      declaredNodes_ = (int64_t)h.nodeCount;
+      // 세 열을 각자의 FILE로 순차 읽기
+      const long base = (long)sizeof(h);
+      const long column = (long)(h.edgeCount * sizeof(uint32_t));
+      std::fclose(text_);
+      text_ = nullptr;
+      for (int c = 0; c < 3; c++) {
+        cols_[c] = std::fopen(path, "rb");
+        if (!cols_[c] || std::fseek(cols_[c], base + c * column, SEEK_SET) != 0) {
+          std::fprintf(stderr, "external: cannot read %s\n", path);
+          return false;
+        }
+      }
+      bytes_ += sizeof(h);
+      return true;
+    }
+    std::rewind(text_);
+    return true;
+  }
+
+  // 최대 max개를 읽음. 끝이면 0, 오류면 failed()
+  size_t read(RunEdge *out, size_t max) {
+    return binary_ ? readBinary(out, max) : readText(out, max);
+  }
+
+  bool failed() const { return failed_; }
+  uint64_t bytes() const { return bytes_; }
+  // 남은 간선 수를 알면 그 값 (바이너리), 모르면 UINT64_MAX (텍스트)
+  uint64_t remainingHint() const { return binary_ ? remaining_ : UINT64_MAX; }
+
+  // 다 읽은 뒤에 호출 (텍스트는 선언 값과 최대 번호+1 중 큰 값)
+  uint32_t nodeCount() const {
+    return (uint32_t)(declaredNodes_ > maxId_ + 1 ? declaredNodes_ : maxId_ + 1);
+  }
+
+  void close() {
+    if (text_)
+      std::fclose(text_);
+    std::free(line_);
+    line_ = nullptr;
+    lineCap_ = 0;
+    for (int c = 0; c < 3; c++) {
+      if (cols_[c])
+        std::fclose(cols_[c]);
+      cols_[c] = nullptr;
+    }
+    text_ = nullptr;
+  }
+
+private:
+  size_t readBinary(RunEdge *out, size_t max) {
+    uint32_t u[EXTERNAL_STAGE], v[EXTERNAL_STAGE];
+    int32_t w[EXTERNAL_STAGE];
+    size_t total = 0;
+    while (total < max && remaining_ > 0) {
+      size_t k = std::min<uint64_t>(std::min<size_t>(max - total, EXTERNAL_STAGE),
+                                    remaining_);
+      if (std::fread(u, 4, k, cols_[0]) != k || std::fread(v, 4, k, cols_[1]) != k ||
+          std::fread(w, 4, k, cols_[2]) != k) {
+        std::fprintf(stderr, "external: truncated binary graph\n");
+        failed_ = true;
+        return 0;
+      }
+      for (size_t i = 0; i < k; i++) {
+        if (u[i] >= (uint64_t)declaredNodes_ || v[i] >= (uint64_t)declaredNodes_) {
+          std::fprintf(stderr, "external: edge out of range\n");
+          failed_ = true;
+          return 0;
+        }
+        out[total + i] = RunEdge{w[i], u[i], v[i]};
+      }
+      total += k;
+      remaining_ -= k;
+      bytes_ += 12 * k;
+    }
+    return total;
+  }
+
+  // 줄 첫 글자로 판단: 'p' 헤더, 'a'/'e' DIMACS 간선(1부터), 숫자 SNAP 간선(0부터)
+  // getline()으로 줄 길이 제한 없음 (mmap 경로 parseTextGraph()와 같은 줄 단위)
+  size_t readText(RunEdge *out, size_t max) {
+    size_t total = 0;
+    ssize_t got;
+    while (total < max && (got = getline(&line_, &lineCap_, text_)) >= 0) {
+      lineNo_++;
+      const size_t len = (size_t)got;
+      bytes_ += len;
+      TextCursor c{line_, line_ + len};
+      c.skipBlanks();
+      if (c.p >= c.end)
+        continue;
+      const char lead = *c.p;
+      if (lead == 'p') {
+        c.p++;
+        c.skipBlanks();
+        while (c.p < c.end && *c.p != ' ' && *c.p != '\t')
+          c.p++;
+        if (c.readInt(declaredNodes_) && declaredNodes_ > UINT32_MAX) {
+          std::fprintf(stderr, "external: node count too large at line %zu\n",
+                       lineNo_);
+          failed_ = true;
+          return 0;
+        }
+        continue;
+      }
+      int64_t base;
+      if (lead == 'a' || lead == 'e') {
+        c.p++;
+        base = 1;
+      } else if (lead >= '0' && lead <= '9') {
+        base = 0;
+      } else {
+        continue;
+      }
+      int64_t a, b, w = 1;
+      if (!c.readInt(a) || !c.readInt(b) || a < base || b < base ||
+          a - base >= (int64_t)UINT32_MAX || b - base >= (int64_t)UINT32_MAX ||
+          (!c.atLineEnd() &&
+           (!c.readInt(w) || w < INT32_MIN || w > INT32_MAX))) {
+        std::fprintf(stderr, "external: parse error at line %zu\n", lineNo_);
+        failed_ = true;
+        return 0;
+      }
+      a -= base;
+      b -= base;
+      maxId_ = std::max(maxId_, std::max(a, b));
+      out[total++] = RunEdge{(int32_t)w, (uint32_t)a, (uint32_t)b};
+    }
+    return total;
+  }
+
+  FILE *text_ = nullptr;
+  char *line_ = nullptr; // getline() 버퍼 (가장 긴 줄만큼 자람)
+  size_t lineCap_ = 0;
+  FILE *cols_[3] = {nullptr, nullptr, nullptr};
+  bool binary_ = false;
+  bool failed_ = false;
+  uint64_t remaining_ = 0;
+  uint64_t bytes_ = 0;
+  int64_t declaredNodes_ = 0;
+  int64_t maxId_ = -1;
+  size_t lineNo_ = 0;
+};
+
+// ============================================================================
+// 2. 런 파일
+// ============================================================================
+
+// 런 하나를 버퍼 단위로 읽는 커서
+struct RunCursor {
+  FILE *f = nullptr;
+  std::vector<RunEdge> buf;
+  size_t pos = 0, len = 0;
+  uint64_t *bytesRead = nullptr;
+
+  bool open(const std::string &path, size_t records, uint64_t *counter) {
+    f = std::fopen(path.c_str(), "rb");
+    buf.resize(records ? records : 1);
+    bytesRead = counter;
+    return f != nullptr;
+  }
+  bool next(RunEdge &e) {
+    if (pos == len) {
+      len = std::fread(buf.data(), sizeof(RunEdge), buf.size(), f);
+      *bytesRead += len * sizeof(RunEdge);
+      pos = 0;
+      if (len == 0)
+        return false;
+    }
+    e = buf[pos++];
+    return true;
+  }
+  ~RunCursor() {
+    if (f)
+      std::fclose(f);
+  }
+};
+
+// ============================================================================
+// 3. 런 생성 -> 병합 -> Kruskal
+// ============================================================================
+
+class ExternalKruskal {
+public:
+  ExternalKruskal(size_t memoryBytes, const char *tmpDir)
+      : memory_(std::max<size_t>(memoryBytes, 2 * EXTERNAL_MIN_BUFFER)),
+        tmpDir_(tmpDir ? tmpDir : "/tmp") {}
+
+  ~ExternalKruskal() {
+    for (size_t i = 0; i < runs_.size(); i++)
+      std::remove(runs_[i].c_str());
+  }
+
+  // treeOut이 있으면 트리 간선을 "u v w" 줄로 씀
+  bool run(const char *path, FILE *treeOut, ExternalStats &stats) {
+    stats = ExternalStats();
+    double t0 = nowMs();
+    if (!formRuns(path, stats))
+      return false;
+    stats.runMs = nowMs() - t0;
+
+    t0 = nowMs();
+    // 런 하나당 버퍼가 EXTERNAL_MIN_BUFFER 이상이 되도록 한 번에 병합할 개수 제한
+    const size_t fanIn = std::max<size_t>(2, memory_ / EXTERNAL_MIN_BUFFER - 1);
+    while (runs_.size() > fanIn) {
+      // 이번 단계 동안 runs_는 입력 런 + 새로 만든 런 (중간에 실패해도 소멸자가 모두 지움)
+      const size_t inputs = runs_.size();
+      std::vector<std::string> next;
+      for (size_t i = 0; i < inputs; i += fanIn) {
+        size_t end = std::min(inputs, i + fanIn);
+        std::vector<std::string> group(runs_.begin() + i, runs_.begin() + end);
+        std::string out = runPath();
+        runs_.push_back(out); // 쓰기 전에 등록
+        next.push_back(out);
+        FILE *f = std::fopen(out.c_str(), "wb");
+        if (!f)
+          return fail("cannot create run file");
+        bool written = true;
+        bool ok = merge(group, stats, [&](const RunEdge &e) {
+          stats.runBytesWritten += sizeof(RunEdge);
+          written = std::fwrite(&e, sizeof(e), 1, f) == 1;
+          return written;
+        });
+        if (std::fclose(f) != 0 || !ok || !written)
+          return fail("cannot write run file");
+        for (size_t g = 0; g < group.size(); g++)
+          std::remove(group[g].c_str());
+      }
+      runs_.swap(next);
+      stats.mergePasses++;
+    }
+
+    // 마지막 병합 -> Kruskal
+    DisjointSet<uint32_t> sets(stats.nodeCount);
+    stats.unionFindBytes = (size_t)stats.nodeCount * 2 * sizeof(uint32_t);
+    const uint32_t target = stats.nodeCount ? stats.nodeCount - 1 : 0;
+    bool ok = merge(runs_, stats, [&](const RunEdge &e) {
+      stats.streamed++;
+      if (sets.unite(e.u, e.v)) {
+        stats.weight += e.w;
+        stats.treeEdges++;
+        if (treeOut)
+          std::fprintf(treeOut, "%u %u %d\n", e.u, e.v, e.w);
+      }
+      return stats.treeEdges < target; // 트리가 완성되면 중단
+    });
+    stats.mergeMs = nowMs() - t0;
+    return ok;
+  }
+
+private:
+  static double nowMs() {
+    using namespace std::chrono;
+    return duration_cast<duration<double, std::milli>>(
+               steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  bool fail(const char *what) {
+    std::fprintf(stderr, "external: %s\n", what);
+    return false;
+  }
+
+  std::string runPath() {
+    char name[64];
+    std::snprintf(name, sizeof(name), "/vag_run_%d_%u.bin", (int)getpid(),
+                  nextRun_++);
+    return tmpDir_ + name;
+  }
+
+  // 예산만큼 읽어 정렬 -> 런 파일 하나
+  bool formRuns(const char *path, ExternalStats &stats) {
+    EdgeStream in;
+    if (!in.open(path))
+      return false;
+    std::vector<RunEdge> buf(std::max<uint64_t>(
+        1, std::min<uint64_t>(memory_ / sizeof(RunEdge), in.remainingHint())));
+    stats.bufferBytes = buf.size() * sizeof(RunEdge);
+    while (true) {
+      size_t k = in.read(buf.data(), buf.size());
+      if (in.failed())
+        return false;
+      if (k == 0)
+        break;
+      std::sort(buf.begin(), buf.begin() + k,
+                [](const RunEdge &a, const RunEdge &b) { return a.w < b.w; });
+      std::string out = runPath();
+      FILE *f = std::fopen(out.c_str(), "wb");
+      if (!f)
+        return fail("cannot create run file");
+      runs_.push_back(out);
+      bool ok = std::fwrite(buf.data(), sizeof(RunEdge), k, f) == k;
+      if (std::fclose(f) != 0 || !ok)
+        return fail("cannot write run file");
+      stats.edges += k;
+      stats.runBytesWritten += k * sizeof(RunEdge);
+      stats.runs++;
+    }
+    stats.inputBytes = in.bytes();
+    stats.nodeCount = in.nodeCount();
+    return true;
+  }
+
+  // k-way 병합: 런마다 버퍼 하나, 머리 원소로 최소 힙. sink가 false면 중단
+  template <typename Sink>
+  bool merge(const std::vector<std::string> &group, ExternalStats &stats,
+             Sink sink) {
+    const size_t records =
+        memory_ / (group.size() + 1) / sizeof(RunEdge); // +1: 쓰기 버퍼 몫
+    std::vector<RunCursor> cursors(group.size());
+    std::vector<RunEdge> head(group.size());
+    std::vector<uint32_t> heap;
+    for (size_t i = 0; i < group.size(); i++) {
+      if (!cursors[i].open(group[i], records, &stats.runBytesRead))
+        return fail("cannot open run file");
+      if (cursors[i].next(head[i]))
+        heap.push_back((uint32_t)i);
+    }
+    auto later = [&head](uint32_t a, uint32_t b) { return head[a].w > head[b].w; };
+    std::make_heap(heap.begin(), heap.end(), later);
+    while (!heap.empty()) {
+      std::pop_heap(heap.begin(), heap.end(), later);
+      const uint32_t r = heap.back();
+      if (!sink(head[r]))
+        return true;
+      if (cursors[r].next(head[r]))
+        std::push_heap(heap.begin(), heap.end(), later);
+      else
+        heap.pop_back();
+    }
+    return true;
+  }
+
+  size_t memory_;
+  std::string tmpDir_;
+  std::vector<std::string> runs_;
+  unsigned nextRun_ = 0;
+};
+
+#endif
@@ -0,0 +1,569 @@
+// 실행 명령어 형식: g++ -std=c++17 -O2 -DTARGET_PC graph_bench.cpp -o graph_bench
+// 그래프 엔진 벤치마크 (PC 전용, 헤드리스)
+//   ./graph_bench sort [최대지수]   간선 정렬 10^3 ~ 10^최대지수개 (기본 7, 최대 8)
+//   ./graph_bench convert IN OUT    DIMACS/SNAP 텍스트 -> 바이너리(.vag) 변환
+//   ./graph_bench gen OUT 정점수 [평균차수] [스레드]  무작위 기하 그래프를 .vag로 바로 생성
+//                                   (기본 평균 차수 6, 스레드 0 = 코어 수)
+//   ./graph_bench dynamic [정점수] [변경수]  동적 MST 추가/삭제 (Kruskal로 검증)
+//   ./graph_bench emst [점수]       좌표 유클리드 MST (작은 입력은 O(n^2) Prim으로 검증)
+//   ./graph_bench mst [최대지수] [계열]  생성 그래프 계열별 MST 엔진 비교, 간선 10^2 ~ 10^최대지수
+//                                   (기본 6, 최대 7, 계열: geometric grid powerlaw complete)
+//   ./graph_bench layout [최대정점수] 힘 기반 LED 배치 (graph_layout.h), 정점 100 ~ 최대 (기본 10000)
+
+#ifndef TARGET_PC
+#error "graph_bench.cpp는 PC 전용입니다 (-DTARGET_PC로 빌드)"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "dynamic_mst.h"
+#include "emst.h"
+#include "graph_csr.h"
+#include "graph_edges.h"
+#include "graph_gen.h"
+#include "graph_layout.h"
+#include "mst_engines.h"
+#include "mst_verify.h"
+
+// ============================================================================
+// 1. 공통 유틸
+// ============================================================================
+
+static double nowMs() {
+  using namespace std::chrono;
+  return duration_cast<duration<double, std::milli>>(
+             steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// 재현 가능한 입력을 위한 xorshift64
+struct BenchRng {
+  uint64_t state;
+  explicit BenchRng(uint64_t seed) : state(seed ? seed : 88172645463325252ULL) {}
+  uint64_t next() {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+  uint32_t below(uint32_t bound) { return (uint32_t)(next() % bound); }
+};
+
+static EdgeList randomEdges(size_t m, uint32_t nodeCount, uint32_t maxWeight,
+                            uint64_t seed) {
+  BenchRng rng(seed);
+  EdgeList edges;
+  edges.nodeCount = nodeCount;
+  edges.reserve(m);
+  for (size_t i = 0; i < m; i++)
+    edges.add(rng.below(nodeCount), rng.below(nodeCount),
+              (int32_t)rng.below(maxWeight));
+  return edges;
+}
+
+static bool sameOrder(const EdgeList &a, const EdgeList &b) {
+  return a.u == b.u && a.v == b.v && a.w == b.w;
+}
+
+// ============================================================================
+// 2. 간선 정렬 벤치마크
+// ============================================================================
+// radix: radixSortEdges, intro: introSortEdges(정수 키), stable: std::stable_sort
+// 세 결과가 모두 같은 순서(같은 가중치는 원래 순서)인지 함께 확인
+
+static void benchSortOne(size_t m, uint32_t maxWeight) {
+  const uint32_t nodeCount = (uint32_t)std::max<size_t>(16, m / 8);
+  EdgeList original = randomEdges(m, nodeCount, maxWeight, m * 31 + maxWeight);
+
+  EdgeList radix = original;
+  double t0 = nowMs();
+  radixSortEdges(radix);
+  double radixMs = nowMs() - t0;
+
+  EdgeList intro = original;
+  t0 = nowMs();
+  introSortEdges(intro, intro.w);
+  double introMs = nowMs() - t0;
+
+  // 기준: 간선 인덱스를 안정 정렬
+  std::vector<uint32_t> perm(m);
+  for (size_t i = 0; i < m; i++)
+    perm[i] = (uint32_t)i;
+  t0 = nowMs();
+  std::stable_sort(perm.begin(), perm.end(), [&](uint32_t a, uint32_t b) {
+    return original.w[a] < original.w[b];
+  });
+  EdgeList stable = original;
+  applyPermutation(stable, perm);
+  double stableMs = nowMs() - t0;
+
+  bool ok = sameOrder(radix, stable) && sameOrder(intro, stable);
+  std::printf("SORT: edges=%zu weights<%u radix_ms=%.2f intro_ms=%.2f "
+              "stable_sort_ms=%.2f radix_medges_s=%.1f %s\n",
+              m, maxWeight, radixMs, introMs, stableMs,
+              radixMs > 0 ? m / radixMs / 1000.0 : 0.0, ok ? "ok" : "MISMATCH");
+  std::fflush(stdout);
+}
+
+static void benchSort(int maxExp) {
+  size_t m = 1000;
+  for (int e = 3; e <= maxExp; e++, m *= 10) {
+    benchSortOne(m, 16);         // 데모처럼 작은 가중치 (동점 많음)
+    benchSortOne(m, 0x7FFFFFFF); // 넓은 범위 가중치
+  }
+}
+
+// ============================================================================
+// 3. 그래프 파일 변환 / 생성
+// ============================================================================
+
+static int convertGraph(const char *in, const char *out) {
+  EdgeList edges;
+  double t0 = nowMs();
+  if (!loadGraph(in, edges))
+    return 1;
+  double t1 = nowMs();
+  if (!writeBinaryGraph(out, edges)) {
+    std::fprintf(stderr, "graph: cannot write %s\n", out);
+    return 1;
+  }
+  std::printf("CONVERT: nodes=%u edges=%zu parse_ms=%.1f write_ms=%.1f\n",
+              edges.nodeCount, edges.size(), t1 - t0, nowMs() - t1);
+  return 0;
+}
+
+// 무작위 기하 그래프를 .vag로 바로 생성 (graph_gen.h writeGeometricGraph)
+// 작은 입력은 다시 읽어 단일 스레드 generateGeometric() 결과와 비교
+#define GEN_CHECK_MAX 2000000
+
+static int generateGraphFile(const char *out, uint32_t n, double degree,
+                             unsigned threads) {
+  GeometricFileStats stats;
+  if (!writeGeometricGraph(out, n, degree, n, stats, threads)) {
+    std::fprintf(stderr, "graph: cannot write %s\n", out);
+    return 1;
+  }
+  std::printf("GEN: nodes=%u edges=%llu avg_degree=%.2f radius=%.1f threads=%u "
+              "grid_count_ms=%.1f write_ms=%.1f mb=%.1f",
+              n, (unsigned long long)stats.edges,
+              n ? 2.0 * stats.edges / n : 0.0, stats.radius, stats.threads,
+              stats.countMs, stats.writeMs,
+              (sizeof(BinaryGraphHeader) + stats.edges * 12) / 1048576.0);
+  if (n <= GEN_CHECK_MAX) {
+    EdgeList written, expected;
+    bool ok = loadGraph(out, written);
+    generateGeometric(n, degree, n, expected, 1);
+    ok = ok && written.nodeCount == n && sameOrder(written, expected);
+    std::printf(" %s", ok ? "ok" : "MISMATCH");
+    if (!ok) {
+      std::printf("\n");
+      return 1;
+    }
+  }
+  std::printf("\n");
+  return 0;
+}
+
+// ============================================================================
+// 4. 동적 MST 벤치마크
+// ============================================================================
+// 정점 n개, 간선 4n개로 시작해서 무작위 추가/삭제를 반복
+// 일정 간격마다 살아 있는 간선으로 kruskalMST()를 돌려 가중치 비교
+
+static bool checkDynamic(const DynamicMst &dyn) {
+  EdgeList live;
+  live.nodeCount = dyn.nodeCount();
+  for (uint32_t id = 0; id < dyn.idLimit(); id++) {
+    if (dyn.live(id))
+      live.add(dyn.edgeU(id), dyn.edgeV(id), dyn.edgeWeight(id));
+  }
+  MstResult expected;
+  kruskalMST(live, expected);
+  return expected.weight == dyn.weight() &&
+         expected.edgeIds.size() == dyn.treeEdges();
+}
+
+static int benchDynamic(uint32_t n, uint32_t ops) {
+  BenchRng rng(n * 131 + ops);
+  DynamicMst dyn(n);
+  std::vector<uint32_t> ids;
+  double t0 = nowMs();
+  for (uint32_t i = 0; i < 4 * n; i++)
+    ids.push_back(dyn.insert(rng.below(n), rng.below(n), (int32_t)rng.below(1000000)));
+  double buildMs = nowMs() - t0;
+
+  const uint32_t checkEvery = ops / 10 ? ops / 10 : 1;
+  uint32_t inserts = 0, erases = 0, treeChanges = 0, checks = 0;
+  double opMs = 0;
+  bool ok = checkDynamic(dyn);
+  for (uint32_t k = 0; k < ops; k++) {
+    MstChange change;
+    t0 = nowMs();
+    if (ids.empty() || rng.below(2) == 0) {
+      ids.push_back(dyn.insert(rng.below(n), rng.below(n),
+                               (int32_t)rng.below(1000000), &change));
+      inserts++;
+    } else {
+      uint32_t slot = rng.below((uint32_t)ids.size());
+      dyn.erase(ids[slot], &change);
+      ids[slot] = ids.back();
+      ids.pop_back();
+      erases++;
+    }
+    opMs += nowMs() - t0;
+    if (change.added != DYNAMIC_MST_NONE || change.removed != DYNAMIC_MST_NONE)
+      treeChanges++;
+    if ((k + 1) % checkEvery == 0) {
+      ok = ok && checkDynamic(dyn);
+      checks++;
+    }
+  }
+
+  std::printf("DYNAMIC: nodes=%u build_ms=%.1f ops=%u inserts=%u erases=%u "
+              "tree_changes=%u us_per_op=%.2f scans_per_erase=%.1f "
+              "weight=%lld checks=%u %s\n",
+              n, buildMs, ops, inserts, erases, treeChanges,
+              ops ? opMs * 1000.0 / ops : 0.0,
+              erases ? (double)dyn.replacementScans() / erases : 0.0,
+              (long long)dyn.weight(), checks, ok ? "ok" : "MISMATCH");
+  return ok ? 0 : 1;
+}
+
+// ============================================================================
+// 5. 유클리드 MST 벤치마크
+// ============================================================================
+// 0..EMST_MAX_COORD 격자 위 무작위 점 (중복 점, 같은 거리 간선 포함)
+// 점 4096개 이하는 완전 그래프 위 O(n^2) Prim의 제곱거리 합과 비교
+
+static int64_t bruteForceEmst(const PointSet &pts) {
+  const size_t n = pts.size();
+  std::vector<int64_t> best(n, INT64_MAX);
+  std::vector<char> inTree(n, 0);
+  int64_t total = 0;
+  size_t next = 0;
+  for (size_t k = 0; k < n; k++) {
+    size_t v = next;
+    inTree[v] = 1;
+    if (k)
+      total += best[v];
+    int64_t nearest = INT64_MAX;
+    for (size_t i = 0; i < n; i++) {
+      if (inTree[i])
+        continue;
+      int64_t dx = pts.x[i] - pts.x[v], dy = pts.y[i] - pts.y[v];
+      best[i] = std::min(best[i], dx * dx + dy * dy);
+      if (best[i] < nearest) {
+        nearest = best[i];
+        next = i;
+      }
+    }
+  }
+  return total;
+}
+
+static bool benchEmstOne(uint32_t n, int32_t span) {
+  BenchRng rng(n * 7919ULL + (uint64_t)span);
+  PointSet pts;
+  for (uint32_t i = 0; i < n; i++)
+    pts.add((int32_t)rng.below(span + 1), (int32_t)rng.below(span + 1));
+
+  EdgeList candidates;
+  MstResult tree;
+  EmstStats stats;
+  double t0 = nowMs();
+  if (!euclideanMST(pts, candidates, tree, stats))
+    return false;
+  double ms = nowMs() - t0;
+
+  bool ok = tree.edgeIds.size() + 1 == n;
+  const char *check = "-";
+  if (n <= 4096) {
+    ok = ok && bruteForceEmst(pts) == tree.weight;
+    check = ok ? "ok" : "MISMATCH";
+  }
+  std::printf("EMST: points=%u span=%d ms=%.1f rounds=%u candidates=%zu "
+              "dist_per_point=%.1f length=%.1f check=%s\n",
+              n, span, ms, stats.rounds, candidates.size(),
+              n ? (double)stats.distanceEvals / n : 0.0, stats.length, check);
+  return ok;
+}
+
+static int benchEmst(uint32_t maxPoints) {
+  bool ok = true;
+  // 좁은 범위 = 중복 점과 같은 거리 간선이 많은 경우
+  ok = benchEmstOne(1000, 30) && ok;
+  ok = benchEmstOne(4096, EMST_MAX_COORD) && ok;
+  for (uint32_t n = 10000; n <= maxPoints; n *= 10)
+    ok = benchEmstOne(n, EMST_MAX_COORD) && ok;
+  return ok ? 0 : 1;
+}
+
+// ============================================================================
+// 6. MST 엔진 비교 (생성 그래프 계열)
+// ============================================================================
+// 계열마다 간선 수 10^k개 정도의 그래프를 만들고 모든 MST 엔진을 같은 입력으로 실행
+// 각 엔진: 시간, 초당 간선 수, 최대 RSS, MST 가중치 (엔진끼리 다르면 MISMATCH)
+// 각 엔진의 결과 트리를 verifyMst로 따로 검증 (verify_ms, 실패하면 INVALID)
+// Prim은 CSR 구성 시간을 포함 (다른 엔진은 간선 목록을 바로 씀)
+// unexamined: Union-Find 검사까지 가지 않은 간선 수 (Prim은 인접 슬롯을 세므로 0)
+// 최대 RSS는 실행 전에 /proc/self/clear_refs로 초기화한 VmHWM (extra = 실행 전 RSS 대비 증가분)
+
+#include <sys/resource.h>
+
+static long procStatusKb(const char *field) {
+  FILE *f = std::fopen("/proc/self/status", "r");
+  if (!f)
+    return -1;
+  char line[256];
+  long kb = -1;
+  const size_t len = std::strlen(field);
+  while (std::fgets(line, sizeof(line), f)) {
+    if (std::strncmp(line, field, len) == 0) {
+      kb = std::atol(line + len);
+      break;
+    }
+  }
+  std::fclose(f);
+  return kb;
+}
+
+// 최대 RSS 기록을 현재 RSS로 되돌림 (실패하면 getrusage의 전체 최대값을 쓰게 됨)
+static void resetPeakRss() {
+  FILE *f = std::fopen("/proc/self/clear_refs", "w");
+  if (f) {
+    std::fputs("5", f);
+    std::fclose(f);
+  }
+}
+
+static long peakRssKb() {
+  long kb = procStatusKb("VmHWM:");
+  if (kb < 0) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    kb = usage.ru_maxrss;
+  }
+  return kb;
+}
+
+enum MstEngine {
+  ENGINE_KRUSKAL,
+  ENGINE_LAZY,
+  ENGINE_FILTER,
+  ENGINE_BORUVKA,
+  ENGINE_PRIM,
+  ENGINE_COUNT
+};
+
+static const char *const engineNames[ENGINE_COUNT] = {
+    "kruskal", "lazy-kruskal", "filter-kruskal", "boruvka", "prim"};
+
+static void runEngine(int engine, const EdgeList &edges, MstResult &out) {
+  switch (engine) {
+  case ENGINE_KRUSKAL:
+    kruskalMST(edges, out);
+    break;
+  case ENGINE_LAZY:
+    lazyKruskalMST(edges, out);
+    break;
+  case ENGINE_FILTER:
+    filterKruskalMST(edges, out);
+    break;
+  case ENGINE_BORUVKA:
+    boruvkaMST(edges, out);
+    break;
+  default: {
+    CsrGraph g;
+    buildCsr(edges, g);
+    primMST(g, out);
+    break;
+  }
+  }
+}
+
+static const char *const mstFamilies[] = {"geometric", "grid", "powerlaw",
+                                          "complete"};
+
+static bool isMstFamily(const char *family) {
+  for (const char *known : mstFamilies)
+    if (std::strcmp(family, known) == 0)
+      return true;
+  return false;
+}
+
+// 간선 수가 대략 target이 되도록 계열별 크기를 정해 생성 (모르는 계열이면 false)
+static bool generateFamily(const char *family, uint64_t target, EdgeList &edges) {
+  const uint64_t seed = target * 2654435761ULL;
+  if (std::strcmp(family, "geometric") == 0) {
+    generateGeometric((uint32_t)(target / 4), 8.0, seed, edges); // 평균 차수 8
+  } else if (std::strcmp(family, "grid") == 0) {
+    uint32_t side = (uint32_t)std::sqrt(target / 2.0) + 1;
+    generateGrid(side, side, 1000000, seed, edges);
+  } else if (std::strcmp(family, "powerlaw") == 0) {
+    generatePowerLaw((uint32_t)(target / 4), 4, 1000000, seed, edges);
+  } else if (std::strcmp(family, "complete") == 0) {
+    uint32_t n = (uint32_t)std::sqrt(2.0 * target) + 1;
+    generateComplete(n, n, seed, edges); // 가중치 n종류, 각각 약 n/2번 중복
+  } else {
+    return false;
+  }
+  return true;
+}
+
+static bool benchMstOne(const char *family, uint64_t target) {
+  EdgeList edges;
+  double t0 = nowMs();
+  if (!generateFamily(family, target, edges)) {
+    std::fprintf(stderr, "mst: unknown family %s\n", family);
+    return false;
+  }
+  double genMs = nowMs() - t0;
+  std::printf("MST: family=%s nodes=%u edges=%zu gen_ms=%.1f\n", family,
+              edges.nodeCount, edges.size(), genMs);
+
+  bool ok = true;
+  int64_t expected = 0;
+  for (int e = 0; e < ENGINE_COUNT; e++) {
+    MstResult result;
+    const long baseKb = procStatusKb("VmRSS:");
+    resetPeakRss();
+    t0 = nowMs();
+    runEngine(e, edges, result);
+    const double ms = nowMs() - t0;
+    const long peakKb = peakRssKb();
+    if (e == 0)
+      expected = result.weight;
+    const bool same = result.weight == expected;
+    t0 = nowMs();
+    const MstVerifyResult check = verifyMst(edges, result.edgeIds);
+    const double verifyMs = nowMs() - t0;
+    const bool valid = check.ok && check.treeWeight == result.weight;
+    ok = ok && same && valid;
+    std::printf("  %-14s ms=%9.2f medges_per_s=%8.2f peak_mb=%7.1f "
+                "extra_mb=%7.1f components=%u unexamined=%llu weight=%lld "
+                "verify_ms=%.2f %s%s\n",
+                engineNames[e], ms, ms > 0 ? edges.size() / ms / 1000.0 : 0.0,
+                peakKb / 1024.0,
+                baseKb >= 0 && peakKb >= baseKb ? (peakKb - baseKb) / 1024.0 : 0.0,
+                result.components,
+                (unsigned long long)(result.examined < edges.size()
+                                         ? edges.size() - result.examined
+                                         : 0),
+                (long long)result.weight, verifyMs, same ? "ok" : "MISMATCH",
+                valid ? "" : " INVALID");
+    if (!valid)
+      std::printf("    verify: %s violations=%llu\n",
+                  check.error ? check.error : "cycle property",
+                  (unsigned long long)check.violations);
+  }
+  return ok;
+}
+
+static int benchMst(int maxExp, const char *onlyFamily) {
+  bool ok = true;
+  for (const char *family : mstFamilies) {
+    if (onlyFamily && std::strcmp(onlyFamily, family) != 0)
+      continue;
+    uint64_t target = 100;
+    for (int k = 2; k <= maxExp; k++, target *= 10)
+      ok = benchMstOne(family, target) && ok;
+  }
+  return ok ? 0 : 1;
+}
+
+// ============================================================================
+// 7. 그래프 배치 (force-directed)
+// ============================================================================
+// 16x16 캔버스에 수백 정점 (첫 프레임 전에 끝나야 하는 크기) + 큰 캔버스에서 규모 확장
+// 큰 캔버스는 픽셀의 1/4만 채우도록 한 변 = 2 sqrt(n)
+// us_per_node_iter가 n에 따라 거의 일정하면 격자 반발력이 반복당 O(n)
+
+static void benchLayoutOne(const char *family, uint32_t n, int side) {
+  EdgeList edges;
+  if (std::strcmp(family, "geometric") == 0)
+    generateGeometric(n, 4.0, n, edges);
+  else
+    generatePowerLaw(n, 1, 16, n, edges);
+  LedLayout layout;
+  LayoutStats stats;
+  layoutGraph(edges, side, side, layout, stats);
+  std::printf("LAYOUT: family=%-9s nodes=%7u edges=%7zu canvas=%4dx%-4d "
+              "force_ms=%8.1f us_per_node_iter=%.3f place_ms=%7.1f moved=%u "
+              "overlaps=%u untangled=%u edge_node_hits=%u\n",
+              family, n, edges.size(), side, side, stats.forceMs,
+              stats.iterations ? stats.forceMs * 1000 / stats.iterations / n
+                               : 0.0,
+              stats.placeMs, stats.moved, stats.overlaps, stats.untangled,
+              stats.edgeNodeHits);
+}
+
+static int benchLayout(uint32_t maxNodes) {
+  static const char *const families[] = {"geometric", "powerlaw"};
+  for (const char *family : families) {
+    for (uint32_t n = 100; n <= 200; n += 100)
+      benchLayoutOne(family, n, 16);
+    for (uint32_t n = 100; n <= maxNodes; n *= 10)
+      benchLayoutOne(family, n, (int)std::ceil(2 * std::sqrt((double)n)));
+  }
+  return 0;
+}
+
+// ============================================================================
+// 8. main
+// ============================================================================
+
+static void usage() {
+  std::printf("usage: graph_bench sort [max_exp]\n"
+              "       graph_bench convert IN OUT\n"
+              "       graph_bench gen OUT nodes [avg_degree] [threads]\n"
+              "       graph_bench dynamic [nodes] [ops]\n"
+              "       graph_bench emst [max_points]\n"
+              "       graph_bench mst [max_exp] [geometric|grid|powerlaw|complete]\n"
+              "       graph_bench layout [max_nodes]\n");
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    usage();
+    return 1;
+  }
+  if (std::strcmp(argv[1], "sort") == 0) {
+    int maxExp = argc > 2 ? std::atoi(argv[2]) : 7;
+    benchSort(std::min(std::max(maxExp, 3), 8));
+    return 0;
+  }
+  if (std::strcmp(argv[1], "dynamic") == 0) {
+    uint32_t n = argc > 2 ? (uint32_t)std::atoi(argv[2]) : 100000;
+    uint32_t ops = argc > 3 ? (uint32_t)std::atoi(argv[3]) : 100000;
+    return benchDynamic(n < 2 ? 2 : n, ops);
+  }
+  if (std::strcmp(argv[1], "mst") == 0) {
+    int maxExp = argc > 2 ? std::atoi(argv[2]) : 6;
+    if (argc > 3 && !isMstFamily(argv[3])) {
+      std::fprintf(stderr, "mst: unknown family %s\n", argv[3]);
+      usage();
+      return 1;
+    }
+    return benchMst(std::min(std::max(maxExp, 2), 7), argc > 3 ? argv[3] : nullptr);
+  }
+  if (std::strcmp(argv[1], "emst") == 0) {
+    uint32_t n = argc > 2 ? (uint32_t)std::atoi(argv[2]) : 1000000;
+    return benchEmst(n);
+  }
+  if (std::strcmp(argv[1], "layout") == 0)
+    return benchLayout(argc > 2 ? (uint32_t)std::atoi(argv[2]) : 10000);
+  if (std::strcmp(argv[1], "convert") == 0 && argc == 4)
+    return convertGraph(argv[2], argv[3]);
+  if (std::strcmp(argv[1], "gen") == 0 && argc >= 4)
+    return generateGraphFile(argv[2], (uint32_t)std::atoi(argv[3]),
+                             argc > 4 ? std::atof(argv[4]) : 6.0,
+                             argc > 5 ? (unsigned)std::atoi(argv[5]) : 0);
+  usage();
+  return 1;
+}
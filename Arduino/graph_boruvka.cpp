@@ -0,0 +1,965 @@
+// Borůvka MST 알고리즘 시각화
+// 통합 하드웨어 템플릿 기반
+
+#ifdef TARGET_PC
+// ================= PC 빌드용 스텁 =================
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cerrno>
+#include <cstdio>
+#include <math.h>
+#include <thread>
+#include <time.h>
+
+#include "disjoint_set.h"
+#include "emst.h"        // --emst 유클리드 MST
+#include "graph_csr.h"   // --graph 헤드리스 모드
+#include "mst_engines.h"
+
+#define F(x) x
+#define HEX 16
+#define A2 0
+#define INPUT_PULLUP 0
+#define OUTPUT 1
+#define HIGH 1
+#define LOW 0
+
+inline void delay(unsigned long ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(int us) {
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+// 단조 시계 (clock_nanosleep TIMER_ABSTIME과 같은 CLOCK_MONOTONIC 기준)
+struct timespec monotonicOrigin() {
+  static struct timespec origin = [] {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts;
+  }();
+  return origin;
+}
+
+unsigned long micros() {
+  struct timespec origin = monotonicOrigin();
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (unsigned long)((long long)(now.tv_sec - origin.tv_sec) * 1000000LL +
+                         (now.tv_nsec - origin.tv_nsec) / 1000);
+}
+
+void pinMode(int pin, int mode) {}
+void digitalWrite(int pin, int value) {}
+int digitalRead(int pin) { return HIGH; }
+
+unsigned long millis() {
+  static auto start = std::chrono::steady_clock::now();
+  auto now = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::milliseconds>(now - start)
+      .count();
+}
+
+struct SerialType {
+  void begin(unsigned long) {}
+  void print(const char *s) { std::printf("%s", s); }
+  void print(int v) { std::printf("%d", v); }
+  void print(unsigned long v) { std::printf("%lu", v); }
+  void print(uint8_t v, int base) {
+    if (base == HEX)
+      std::printf("%x", v); // Arduino prints without leading zeros
+    else
+      std::printf("%u", v);
+  }
+  void println() {
+    std::printf("\n");
+    std::fflush(stdout);
+  }
+  void println(const char *s) {
+    std::printf("%s\n", s);
+    std::fflush(stdout);
+  }
+  void println(int v) {
+    std::printf("%d\n", v);
+    std::fflush(stdout);
+  }
+  void println(unsigned long v) {
+    std::printf("%lu\n", v);
+    std::fflush(stdout);
+  }
+  int available() { return 0; }
+  int read() { return -1; }
+  int parseInt() { return -1; }
+} Serial;
+
+#define NEO_GRB 0
+#define NEO_KHZ800 0
+
+// WS2812 전송 시간 모델 (800kHz, LED당 24bit x 1.25us)
+// 실제 show()는 전송 동안 인터럽트를 끄므로 시리얼 수신, millis(), 자석 스캔이 멈춤
+#define WS2812_US_PER_LED 30
+#define WS2812_LATCH_US 300        // 래치(reset) 최소 간격 (WS2812B)
+#define WS2812_MILLIS_TICK_US 1024 // AVR timer0 오버플로 주기 (1개만 보류됨)
+#define WS2812_UART_BYTE_US 87     // 115200bps에서 1바이트 수신 시간
+#define WS2812_UART_FIFO 2         // AVR UART 수신 버퍼 (바이트)
+#ifndef WS2812_SIMULATE_TIMING
+#define WS2812_SIMULATE_TIMING 0 // 1이면 show()가 전송 시간만큼 실제로 대기 (-D로 켬)
+#endif
+
+class Adafruit_NeoPixel {
+public:
+  Adafruit_NeoPixel(int n, int /*pin*/, int /*flags*/)
+      : _n(n), _brightness(20), _shows(0), _busyUs(0), _maxIrqOffUs(0),
+        _lostMillisUs(0), _rxOverrunBytes(0) {
+    _pixels = new uint32_t[_n];
+    clear();
+  }
+  ~Adafruit_NeoPixel() { delete[] _pixels; }
+
+  void begin() {}
+  void show() {
+    unsigned long transferUs = (unsigned long)_n * WS2812_US_PER_LED;
+    _shows++;
+    _busyUs += transferUs;
+    if (transferUs > _maxIrqOffUs)
+      _maxIrqOffUs = transferUs;
+    if (transferUs > WS2812_MILLIS_TICK_US)
+      _lostMillisUs += transferUs - WS2812_MILLIS_TICK_US;
+    unsigned long rxBytes = transferUs / WS2812_UART_BYTE_US;
+    if (rxBytes > WS2812_UART_FIFO)
+      _rxOverrunBytes += rxBytes - WS2812_UART_FIFO;
+#if WS2812_SIMULATE_TIMING
+    delayMicroseconds(transferUs);
+#endif
+  }
+  void setBrightness(uint8_t b) { _brightness = b; }
+  uint8_t getBrightness() const { return _brightness; }
+  void clear() {
+    for (int i = 0; i < _n; ++i)
+      _pixels[i] = 0;
+  }
+  uint32_t Color(uint8_t r, uint8_t g, uint8_t b) {
+    return (uint32_t(r) << 16) | (uint32_t(g) << 8) | uint32_t(b);
+  }
+  void setPixelColor(int i, uint32_t c) {
+    if (i >= 0 && i < _n)
+      _pixels[i] = c;
+  }
+  uint32_t getPixelColor(int i) const {
+    if (i >= 0 && i < _n)
+      return _pixels[i];
+    return 0;
+  }
+
+  // 전송 시간 모델 요약: 누적 점유 시간, 최대 인터럽트 차단 구간, 최대 프레임 속도
+  void printTransferStats() const {
+    unsigned long transferUs = (unsigned long)_n * WS2812_US_PER_LED;
+    std::printf("WS2812: leds=%d shows=%lu busy_ms=%lu irq_off_max_us=%lu "
+                "millis_lost_ms=%lu max_fps=%lu rx_overrun_bytes=%lu\n",
+                _n, _shows, _busyUs / 1000, _maxIrqOffUs, _lostMillisUs / 1000,
+                1000000UL / (transferUs + WS2812_LATCH_US), _rxOverrunBytes);
+    std::fflush(stdout);
+  }
+
+private:
+  int _n;
+  uint8_t _brightness;
+  uint32_t *_pixels;
+  unsigned long _shows;
+  unsigned long _busyUs;       // show()에 쓰인 누적 시간
+  unsigned long _maxIrqOffUs;  // 가장 긴 인터럽트 차단 구간
+  unsigned long _lostMillisUs; // 차단 중 놓친 timer0 tick
+  unsigned long _rxOverrunBytes; // 수신이 계속됐다면 차단 중 넘쳤을 UART 바이트
+};
+
+#else
+// ================= 실제 Arduino 빌드용 =================
+#include <Adafruit_NeoPixel.h>
+#include <Arduino.h>
+#include "disjoint_set.h"
+#ifdef __AVR__
+#include <avr/power.h>
+#endif
+#endif
+
+// ============================================================================
+// 1. 하드웨어 설정
+// ============================================================================
+
+#define LED_PIN A2
+#define LED_COUNT 256
+#define LED_WIDTH 16
+#define LED_HEIGHT 16
+
+Adafruit_NeoPixel strip(LED_COUNT, LED_PIN, NEO_GRB + NEO_KHZ800);
+
+// ============================================================================
+// 2. 좌표 변환 함수
+// ============================================================================
+
+int xyToIndex(int x, int y) {
+  if (x < 0 || x >= LED_WIDTH || y < 0 || y >= LED_HEIGHT)
+    return -1;
+  if (y % 2 == 0) {
+    return y * LED_WIDTH + x;
+  } else {
+    return y * LED_WIDTH + (LED_WIDTH - 1 - x);
+  }
+}
+
+// ============================================================================
+// 3. 출력 함수 (LED)
+// ============================================================================
+
+static int currentFrameNumber = 0;
+static uint8_t lastBrightness = 255;
+static float animationSpeed = 1.0;
+
+// 구간별 타이밍 (알고리즘 / 그리기 / 시리얼 출력)
+// -DPROFILE_PHASES=1로 빌드하면 활성화, 아니면 매크로가 모두 빈 코드가 됨
+// 중첩된 구간은 자기 시간만 기록 (예: 그리기 안의 serialPrintFrame은 io로 분리)
+#ifndef PROFILE_PHASES
+#define PROFILE_PHASES 0
+#endif
+
+#if PROFILE_PHASES
+enum Phase { PHASE_ALGO, PHASE_RENDER, PHASE_IO, PHASE_COUNT };
+
+#ifdef TARGET_PC
+#define PHASE_UNIT "ns"
+#define PHASE_SUB_BITS 2 // 2의 거듭제곱 구간을 4칸으로 나눔 (오차 25% 이내)
+static inline uint32_t phaseClock() {
+  return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+#else
+#define PHASE_UNIT "us"
+#define PHASE_SUB_BITS 0 // SRAM 절약: 2의 거듭제곱 단위
+static inline uint32_t phaseClock() { return micros(); }
+#endif
+
+#define PHASE_BUCKETS ((33 - PHASE_SUB_BITS) << PHASE_SUB_BITS)
+
+struct PhaseHistogram {
+  uint32_t count;
+  uint32_t minValue;
+  uint32_t maxValue;
+  uint32_t buckets[PHASE_BUCKETS];
+};
+
+static PhaseHistogram phaseHist[PHASE_COUNT];
+
+// 로그 스케일 버킷 번호
+static uint8_t phaseBucket(uint32_t v) {
+  if (v < (1UL << PHASE_SUB_BITS))
+    return (uint8_t)v;
+  uint8_t msb = 31;
+  while (!(v & (1UL << msb)))
+    msb--;
+  uint8_t sub = (v >> (msb - PHASE_SUB_BITS)) & ((1 << PHASE_SUB_BITS) - 1);
+  return ((msb - PHASE_SUB_BITS + 1) << PHASE_SUB_BITS) + sub;
+}
+
+// 버킷이 담당하는 최대값
+static uint32_t phaseBucketUpper(uint8_t bucket) {
+  if (bucket < (1 << PHASE_SUB_BITS))
+    return bucket;
+  uint8_t msb = (bucket >> PHASE_SUB_BITS) + PHASE_SUB_BITS - 1;
+  uint32_t sub = bucket & ((1 << PHASE_SUB_BITS) - 1);
+  uint32_t lower = (1UL << msb) | (sub << (msb - PHASE_SUB_BITS));
+  return lower + (1UL << (msb - PHASE_SUB_BITS)) - 1;
+}
+
+void phaseRecord(uint8_t phase, uint32_t elapsed) {
+  PhaseHistogram &h = phaseHist[phase];
+  if (h.count == 0 || elapsed < h.minValue)
+    h.minValue = elapsed;
+  if (elapsed > h.maxValue)
+    h.maxValue = elapsed;
+  h.count++;
+  h.buckets[phaseBucket(elapsed)]++;
+}
+
+uint32_t phaseQuantile(uint8_t phase, uint32_t permille) {
+  PhaseHistogram &h = phaseHist[phase];
+  uint32_t rank = (h.count * permille + 999) / 1000;
+  uint32_t seen = 0;
+  for (int i = 0; i < PHASE_BUCKETS; i++) {
+    seen += h.buckets[i];
+    if (seen >= rank && seen > 0) {
+      uint32_t upper = phaseBucketUpper(i);
+      return upper < h.maxValue ? upper : h.maxValue;
+    }
+  }
+  return h.maxValue;
+}
+
+// 스코프 타이머: 생성~소멸 구간을 기록, 안쪽 구간이 열리면 바깥 구간은 잠시 멈춤
+struct PhaseScope {
+  static PhaseScope *active;
+  PhaseScope *parent;
+  uint32_t start;
+  uint32_t elapsed;
+  uint8_t phase;
+  bool merged; // 같은 구간 안에서 다시 열린 경우 바깥 구간에 합침
+
+  explicit PhaseScope(uint8_t p) : parent(active), elapsed(0), phase(p) {
+    merged = parent && parent->phase == p;
+    if (merged)
+      return;
+    start = phaseClock();
+    if (parent)
+      parent->elapsed += start - parent->start;
+    active = this;
+  }
+
+  ~PhaseScope() {
+    if (merged)
+      return;
+    uint32_t now = phaseClock();
+    phaseRecord(phase, elapsed + (now - start));
+    active = parent;
+    if (parent)
+      parent->start = now;
+  }
+};
+
+PhaseScope *PhaseScope::active = 0;
+
+void serialPrintPhaseStats() {
+  static const char *names[PHASE_COUNT] = {"algo", "render", "io"};
+  for (uint8_t p = 0; p < PHASE_COUNT; p++) {
+    Serial.print(F("PHASE:"));
+    Serial.print(names[p]);
+    Serial.print(F(" n="));
+    Serial.print((unsigned long)phaseHist[p].count);
+    Serial.print(F(" min="));
+    Serial.print((unsigned long)phaseHist[p].minValue);
+    Serial.print(F(" p50="));
+    Serial.print((unsigned long)phaseQuantile(p, 500));
+    Serial.print(F(" p99="));
+    Serial.print((unsigned long)phaseQuantile(p, 990));
+    Serial.print(F(" max="));
+    Serial.print((unsigned long)phaseHist[p].maxValue);
+    Serial.println(F(" " PHASE_UNIT));
+  }
+}
+
+// 실행 시작마다 호출: 보고가 그 실행의 구간만 담도록 히스토그램을 비움
+void phaseReset() {
+  for (uint8_t p = 0; p < PHASE_COUNT; p++)
+    phaseHist[p] = PhaseHistogram();
+}
+
+#define PHASE_SCOPE(p) PhaseScope phaseScope(p)
+#define PHASE_REPORT() serialPrintPhaseStats()
+#define PHASE_RESET() phaseReset()
+#else
+#define PHASE_SCOPE(p)
+#define PHASE_REPORT()
+#define PHASE_RESET()
+#endif
+
+void printHex(uint8_t value) {
+  if (value < 16)
+    Serial.print("0");
+  Serial.print(value, HEX);
+}
+
+void serialPrintFrame() {
+  PHASE_SCOPE(PHASE_IO);
+  Serial.print(F("FRAME:"));
+  Serial.println(currentFrameNumber);
+
+  for (int y = 0; y < LED_HEIGHT; y++) {
+    for (int x = 0; x < LED_WIDTH; x++) {
+      int ledIndex = xyToIndex(x, y);
+      uint32_t color = strip.getPixelColor(ledIndex);
+
+      uint8_t r = (color >> 16) & 0xFF;
+      uint8_t g = (color >> 8) & 0xFF;
+      uint8_t b = color & 0xFF;
+
+      printHex(r);
+      printHex(g);
+      printHex(b);
+
+      if (x < LED_WIDTH - 1)
+        Serial.print(" ");
+    }
+    Serial.println();
+  }
+
+  Serial.println(F("---"));
+  currentFrameNumber++;
+}
+
+void setPixel(int x, int y, uint8_t r, uint8_t g, uint8_t b) {
+  int index = xyToIndex(x, y);
+  if (index >= 0) {
+    strip.setPixelColor(index, strip.Color(r, g, b));
+  }
+}
+
+void clearDisplay() { strip.clear(); }
+
+void showDisplay() {
+  PHASE_SCOPE(PHASE_IO);
+  uint8_t currentBrightness = strip.getBrightness();
+  if (currentBrightness != lastBrightness) {
+    Serial.print(F("BRIGHTNESS:"));
+    Serial.println(currentBrightness);
+    lastBrightness = currentBrightness;
+  }
+
+  strip.show();
+  serialPrintFrame();
+}
+
+void setBrightness(uint8_t level) { strip.setBrightness(level); }
+
+// 프레임 페이싱 (절대 마감 기준)
+// 각 스텝의 목표 표시 시각 = 이전 목표 시각 + 지연 시간
+// 그리기/시리얼 출력 시간이 지연에 더해지지 않으므로 오래 실행해도 오차가 누적되지 않음
+#define PACE_MAX_CATCHUP_US 250000UL // 이보다 늦으면 일정을 현재 시각으로 재설정
+
+static unsigned long frameDeadline = 0; // 다음 프레임 목표 시각 (micros)
+static bool frameDeadlineSet = false;
+static unsigned long pacedFrames = 0;
+static unsigned long lateFrames = 0;
+static unsigned long maxLateUs = 0;
+static unsigned long totalLateUs = 0;
+
+void sleepUntilMicros(unsigned long target) {
+#ifdef TARGET_PC
+  struct timespec ts = monotonicOrigin();
+  ts.tv_sec += target / 1000000UL;
+  ts.tv_nsec += (long)(target % 1000000UL) * 1000L;
+  if (ts.tv_nsec >= 1000000000L) {
+    ts.tv_sec++;
+    ts.tv_nsec -= 1000000000L;
+  }
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+  }
+#else
+  // 대부분은 delay()로 자고 마지막 1ms 정도만 micros()로 맞춤
+  long remaining = (long)(target - micros());
+  if (remaining > 2000)
+    delay((remaining - 1000) / 1000);
+  while ((long)(target - micros()) > 0) {
+  }
+#endif
+}
+
+void hardwareDelay(unsigned long ms) {
+  if (animationSpeed <= 0.0)
+    animationSpeed = 1.0;
+
+  unsigned long now = micros();
+  if (!frameDeadlineSet) {
+    frameDeadline = now;
+    frameDeadlineSet = true;
+  }
+  frameDeadline += (unsigned long)(ms * 1000.0 / animationSpeed);
+  pacedFrames++;
+
+  long slack = (long)(frameDeadline - now);
+  if (slack >= 0) {
+    sleepUntilMicros(frameDeadline);
+    return;
+  }
+
+  // 이미 목표 시각을 지남: 지각 프레임으로 기록
+  unsigned long late = (unsigned long)(-slack);
+  lateFrames++;
+  totalLateUs += late;
+  if (late > maxLateUs)
+    maxLateUs = late;
+  if (late > PACE_MAX_CATCHUP_US)
+    frameDeadline = now;
+}
+
+// 실행마다 새로 시작: 통계를 비우고, 이전 실행이나 그 뒤의 대기 시간이
+// 첫 프레임의 지각으로 잡히지 않도록 일정도 다음 hardwareDelay()에서 다시 잡음
+void pacingReset() {
+  frameDeadlineSet = false;
+  pacedFrames = 0;
+  lateFrames = 0;
+  maxLateUs = 0;
+  totalLateUs = 0;
+}
+
+void serialPrintPacingStats() {
+  Serial.print(F("PACING: frames="));
+  Serial.print(pacedFrames);
+  Serial.print(F(" late="));
+  Serial.print(lateFrames);
+  Serial.print(F(" max_late_us="));
+  Serial.print(maxLateUs);
+  Serial.print(F(" avg_late_us="));
+  Serial.println(lateFrames > 0 ? totalLateUs / lateFrames : 0UL);
+}
+
+void setAnimationSpeed(float speed) { animationSpeed = speed; }
+
+// ============================================================================
+// 4. 그래프 알고리즘 - 데이터 구조
+// ============================================================================
+
+#define MAX_NODES 10
+#define MAX_EDGES 25
+
+struct NodePos {
+  int x, y;
+};
+
+struct Edge {
+  int u, v;
+  int weight;
+};
+
+// 10개 노드를 비대칭적으로 배치 (무작위 느낌)
+NodePos nodes[MAX_NODES] = {
+    {3, 2},   // 0
+    {11, 3},  // 1
+    {14, 7},  // 2
+    {13, 13}, // 3
+    {7, 14},  // 4
+    {2, 11},  // 5
+    {5, 7},   // 6
+    {9, 9},   // 7
+    {12, 11}, // 8
+    {7, 4}    // 9
+};
+
+// 20개 간선 (실제 유클리드 거리 기반 가중치)
+// 가중치 = sqrt((x2-x1)^2 + (y2-y1)^2) 반올림
+Edge edges[MAX_EDGES] = {
+    {0, 1, 8}, // (3,2)-(11,3): sqrt(64+1)=8.06
+    {0, 5, 9}, // (3,2)-(2,11): sqrt(1+81)=9.06
+    {0, 9, 4}, // (3,2)-(7,4): sqrt(16+4)=4.47
+    {1, 2, 5}, // (11,3)-(14,7): sqrt(9+16)=5
+    {1, 9, 4}, // (11,3)-(7,4): sqrt(16+1)=4.12
+    {1, 7, 6}, // (11,3)-(9,9): sqrt(4+36)=6.32
+    {2, 3, 6}, // (14,7)-(13,13): sqrt(1+36)=6.08
+    {2, 8, 4}, // (14,7)-(12,11): sqrt(4+16)=4.47
+    {3, 4, 6}, // (13,13)-(7,14): sqrt(36+1)=6.08
+    {3, 8, 2}, // (13,13)-(12,11): sqrt(1+4)=2.24
+    {4, 5, 6}, // (7,14)-(2,11): sqrt(25+9)=5.83
+    {4, 6, 7}, // (7,14)-(5,7): sqrt(4+49)=7.28
+    {4, 7, 5}, // (7,14)-(9,9): sqrt(4+25)=5.39
+    {5, 6, 5}, // (2,11)-(5,7): sqrt(9+16)=5
+    {6, 7, 4}, // (5,7)-(9,9): sqrt(16+4)=4.47
+    {6, 9, 4}, // (5,7)-(7,4): sqrt(4+9)=3.61
+    {7, 8, 4}, // (9,9)-(12,11): sqrt(9+4)=3.61
+    {7, 9, 5}, // (9,9)-(7,4): sqrt(4+25)=5.39
+    {8, 3, 2}, // 중복 제거 (이미 3-8로 표현)
+    {9, 1, 4}  // 중복 제거 (이미 1-9로 표현)
+};
+
+int nodeCount = 10;
+int edgeCount = 20;
+
+// ============================================================================
+// 5. 그래프 시각화 함수
+// ============================================================================
+
+// Bresenham 선 그리기
+void drawLine(int x0, int y0, int x1, int y1, uint8_t r, uint8_t g, uint8_t b) {
+  int dx = abs(x1 - x0);
+  int dy = abs(y1 - y0);
+  int sx = (x0 < x1) ? 1 : -1;
+  int sy = (y0 < y1) ? 1 : -1;
+  int err = dx - dy;
+
+  while (true) {
+    setPixel(x0, y0, r, g, b);
+
+    if (x0 == x1 && y0 == y1)
+      break;
+
+    int e2 = 2 * err;
+    if (e2 > -dy) {
+      err -= dy;
+      x0 += sx;
+    }
+    if (e2 < dx) {
+      err += dx;
+      y0 += sy;
+    }
+  }
+}
+
+// 노드 그리기 (1x1 픽셀)
+// color: 0=회색(기본), 1=흰색(밝게), 2=빨강(현재 선택)
+void drawNode(int nodeId, int color) {
+  if (nodeId < 0 || nodeId >= nodeCount)
+    return;
+
+  int x = nodes[nodeId].x;
+  int y = nodes[nodeId].y;
+
+  uint8_t r, g, b;
+  switch (color) {
+  case 0:
+    r = 0;
+    g = 0;
+    b = 255;
+    break; // 파랑 (기본)
+  case 1:
+    r = 255;
+    g = 255;
+    b = 255;
+    break; // 흰색 (밝게)
+  case 2:
+    r = 255;
+    g = 0;
+    b = 0;
+    break; // 빨강 (현재 선택)
+  default:
+    r = 100;
+    g = 100;
+    b = 100;
+    break;
+  }
+
+  setPixel(x, y, r, g, b);
+}
+
+// 간선 그리기
+// color: 0=회색(기본), 1=노란색(고려중), 2=초록(MST 선택), 3=빨강(거부-사이클)
+void drawEdge(int u, int v, int color) {
+  if (u < 0 || u >= nodeCount || v < 0 || v >= nodeCount)
+    return;
+
+  uint8_t r, g, b;
+  switch (color) {
+  case 0:
+    r = 200;
+    g = 200;
+    b = 200;
+    break; // 흰색 (기본)
+  case 1:
+    r = 255;
+    g = 255;
+    b = 0;
+    break; // 노란색 (고려중)
+  case 2:
+    r = 0;
+    g = 255;
+    b = 0;
+    break; // 초록 (MST 선택)
+  case 3:
+    r = 255;
+    g = 0;
+    b = 0;
+    break; // 빨강 (거부-사이클)
+  default:
+    r = 40;
+    g = 40;
+    b = 40;
+    break;
+  }
+
+  int x0 = nodes[u].x;
+  int y0 = nodes[u].y;
+  int x1 = nodes[v].x;
+  int y1 = nodes[v].y;
+
+  drawLine(x0, y0, x1, y1, r, g, b);
+}
+
+// 그래프 전체 그리기 (모든 간선 + 모든 노드)
+void drawGraph() {
+  PHASE_SCOPE(PHASE_RENDER);
+  // 간선 먼저
+  for (int i = 0; i < edgeCount; i++) {
+    drawEdge(edges[i].u, edges[i].v, 0);
+  }
+  // 노드 나중에 (위에 표시)
+  for (int i = 0; i < nodeCount; i++) {
+    drawNode(i, 0);
+  }
+}
+
+void clearAndDrawGraph() {
+  clearDisplay();
+  drawGraph();
+}
+
+// ============================================================================
+// 6. Borůvka MST 알고리즘 (Union-Find)
+// ============================================================================
+// 라운드마다 모든 컴포넌트가 바깥으로 나가는 가장 가벼운 간선을 동시에 고르고,
+// 고른 간선을 한꺼번에 추가 (한 라운드 = 한 프레임)
+// 같은 가중치는 간선 번호가 작은 쪽을 우선해서 사이클이 생기지 않게 함
+
+// 노드 번호는 MAX_NODES(255 이하)라 uint8_t로 충분 (반복 find, 재귀 없음)
+DisjointSet<uint8_t> sets;
+
+int findSet(int v) { return sets.find(v); }
+
+bool unionSets(int u, int v) {
+  PHASE_SCOPE(PHASE_ALGO);
+  return sets.unite(u, v); // false면 사이클 발생
+}
+
+// MST에 포함된 간선, 이번 라운드에 추가된 간선
+bool inMST[MAX_EDGES];
+bool addedThisRound[MAX_EDGES];
+
+// 컴포넌트 대표별 최소 간선 번호 (-1: 없음)
+int cheapest[MAX_NODES];
+
+// a번 간선이 b번 간선보다 가벼운가 (가중치, 같으면 간선 번호)
+bool lighterEdge(int a, int b) {
+  if (b < 0)
+    return true;
+  if (edges[a].weight != edges[b].weight)
+    return edges[a].weight < edges[b].weight;
+  return a < b;
+}
+
+// 각 컴포넌트의 최소 간선 찾기
+void findCheapestEdges() {
+  PHASE_SCOPE(PHASE_ALGO);
+  for (int c = 0; c < nodeCount; c++) {
+    cheapest[c] = -1;
+  }
+  for (int i = 0; i < edgeCount; i++) {
+    int rootU = findSet(edges[i].u);
+    int rootV = findSet(edges[i].v);
+    if (rootU == rootV)
+      continue;
+    if (lighterEdge(i, cheapest[rootU]))
+      cheapest[rootU] = i;
+    if (lighterEdge(i, cheapest[rootV]))
+      cheapest[rootV] = i;
+  }
+}
+
+// 라운드 결과 그리기: 이전 라운드까지의 MST 간선(초록) + 이번 라운드 간선(노란색)
+void drawBoruvkaRound() {
+  PHASE_SCOPE(PHASE_RENDER);
+  clearDisplay();
+
+  for (int i = 0; i < edgeCount; i++) {
+    drawEdge(edges[i].u, edges[i].v, 0);
+  }
+  for (int i = 0; i < edgeCount; i++) {
+    if (inMST[i] && !addedThisRound[i]) {
+      drawEdge(edges[i].u, edges[i].v, 2);
+    }
+  }
+  for (int i = 0; i < edgeCount; i++) {
+    if (addedThisRound[i]) {
+      drawEdge(edges[i].u, edges[i].v, 1);
+    }
+  }
+
+  // 이번 라운드에 합쳐진 노드는 빨간색
+  for (int k = 0; k < nodeCount; k++) {
+    drawNode(k, 0);
+  }
+  for (int i = 0; i < edgeCount; i++) {
+    if (addedThisRound[i]) {
+      drawNode(edges[i].u, 2);
+      drawNode(edges[i].v, 2);
+    }
+  }
+
+  showDisplay();
+}
+
+void boruvkaMST() {
+  pacingReset();
+  PHASE_RESET();
+  Serial.println(F("\n=== Boruvka MST Algorithm ==="));
+
+  // 1. 초기화
+  sets.resize(nodeCount);
+  for (int i = 0; i < MAX_EDGES; i++) {
+    inMST[i] = false;
+  }
+
+  // 초기 그래프 표시
+  clearAndDrawGraph();
+  showDisplay();
+  hardwareDelay(2000);
+
+  // 2. 라운드 반복: 컴포넌트가 하나가 될 때까지
+  int components = nodeCount;
+  int mstEdgeCount = 0;
+  int mstWeight = 0;
+  int round = 0;
+
+  while (components > 1) {
+    round++;
+    findCheapestEdges();
+
+    Serial.print(F("\nRound "));
+    Serial.print(round);
+    Serial.print(F(" ("));
+    Serial.print(components);
+    Serial.println(F(" components)"));
+
+    for (int i = 0; i < edgeCount; i++) {
+      addedThisRound[i] = false;
+    }
+
+    // 3. 고른 간선을 한꺼번에 추가 (두 컴포넌트가 같은 간선을 고르면 한 번만)
+    int added = 0;
+    for (int c = 0; c < nodeCount; c++) {
+      int e = cheapest[c];
+      if (e < 0 || !unionSets(edges[e].u, edges[e].v))
+        continue;
+
+      Serial.print(F("  Edge "));
+      Serial.print(edges[e].u);
+      Serial.print(F("-"));
+      Serial.print(edges[e].v);
+      Serial.print(F(" weight: "));
+      Serial.println(edges[e].weight);
+
+      inMST[e] = true;
+      addedThisRound[e] = true;
+      added++;
+      mstWeight += edges[e].weight;
+    }
+
+    if (added == 0) {
+      Serial.println(F("  -> Graph is disconnected"));
+      break;
+    }
+    components -= added;
+    mstEdgeCount += added;
+
+    drawBoruvkaRound();
+    hardwareDelay(1500);
+  }
+
+  // 최종 결과
+  Serial.println(F("\n=== MST Complete ==="));
+  Serial.print(F("Rounds: "));
+  Serial.println(round);
+  Serial.print(F("Total edges in MST: "));
+  Serial.println(mstEdgeCount);
+  Serial.print(F("Total weight: "));
+  Serial.println(mstWeight);
+  serialPrintPacingStats();
+  PHASE_REPORT();
+#ifdef TARGET_PC
+  strip.printTransferStats();
+#endif
+
+  // 최종 MST 표시 (MST 간선만 밝게)
+  clearDisplay();
+  for (int i = 0; i < edgeCount; i++) {
+    if (inMST[i]) {
+      drawEdge(edges[i].u, edges[i].v, 2);
+    }
+  }
+  for (int i = 0; i < nodeCount; i++) {
+    drawNode(i, 0);
+  }
+
+  showDisplay();
+  hardwareDelay(3000);
+}
+
+// ============================================================================
+// 7. Setup & Loop
+// ============================================================================
+
+void setup() {
+  Serial.begin(115200);
+
+#ifndef TARGET_PC
+#ifdef __AVR__
+  if (F_CPU == 16000000)
+    clock_prescale_set(clock_div_1);
+#endif
+#endif
+
+  strip.begin();
+  strip.setBrightness(20);
+  strip.show();
+
+  Serial.println(F("========================================"));
+  Serial.println(F("   Boruvka MST Visualization"));
+  Serial.println(F("========================================"));
+
+  hardwareDelay(1000);
+  boruvkaMST();
+}
+
+void loop() {
+  // 알고리즘 완료 후 대기 (프레임이 아니므로 페이싱 밖)
+  delay(1000);
+}
+
+// ============================================================================
+// 8. 헤드리스 모드 (PC 전용): ./graph_boruvka --graph FILE [--threads N]
+// ============================================================================
+// DIMACS / SNAP / 바이너리 그래프를 읽어 시각화 없이 병렬 Borůvka로 MST 계산
+// ./graph_boruvka --emst [POINTS]: 좌표("x y" 줄)로 유클리드 MST, 파일 없으면 데모 좌표
+// N 생략 시 코어 수
+
+#ifdef TARGET_PC
+static double headlessMs() {
+  using namespace std::chrono;
+  return duration_cast<duration<double, std::milli>>(
+             steady_clock::now().time_since_epoch())
+      .count();
+}
+
+int runHeadless(const char *path, unsigned threads) {
+  EdgeList graph;
+  double t0 = headlessMs();
+  if (!loadGraph(path, graph))
+    return 1;
+  double t1 = headlessMs();
+  std::printf("GRAPH: nodes=%u edges=%zu load_ms=%.1f\n", graph.nodeCount,
+              graph.size(), t1 - t0);
+
+  MstResult result;
+  boruvkaMST(graph, result, threads);
+  double mstMs = headlessMs() - t1;
+  std::printf("MST: algo=boruvka tree_edges=%zu weight=%lld components=%u "
+              "examined=%llu rounds=%u mst_ms=%.1f\n",
+              result.edgeIds.size(), (long long)result.weight,
+              result.components, (unsigned long long)result.examined,
+              result.rounds, mstMs);
+  return 0;
+}
+
+// --emst [POINTS]: 좌표로 유클리드 MST 계산
+// 파일을 주지 않으면 nodes[] 좌표를 쓰고, edges[] 가중치 표도 좌표와 대조
+int runEmst(const char *path) {
+  PointSet pts;
+  if (path)
+    return loadPoints(path, pts) ? printEuclideanMST(pts, false) : 1;
+  for (int i = 0; i < nodeCount; i++)
+    pts.add(nodes[i].x, nodes[i].y);
+  // 가중치 표가 좌표와 어긋나면 실패로 끝냄 (EMST 자체는 그래도 출력)
+  int mismatches = checkWeightTable(nodes, nodeCount, edges, edgeCount);
+  int rc = printEuclideanMST(pts, true);
+  return mismatches > 0 ? 1 : rc;
+}
+
+int main(int argc, char **argv) {
+  if (argc >= 2 && std::strcmp(argv[1], "--emst") == 0)
+    return runEmst(argc >= 3 ? argv[2] : nullptr);
+  if (argc >= 3 && std::strcmp(argv[1], "--graph") == 0) {
+    unsigned threads = 0;
+    if (argc >= 5 && std::strcmp(argv[3], "--threads") == 0)
+      threads = (unsigned)std::atoi(argv[4]);
+    return runHeadless(argv[2], threads);
+  }
+  setup();
+  return 0;
+}
+#endif
@@ -0,0 +1,348 @@
+// 그래프 로더 및 CSR(compressed sparse row) 인접 구조 - PC 전용
+// 지원 형식
+//   - DIMACS: "c 주석", "p sp N M", "a U V W" 또는 "e U V [W]" (1부터 시작)
+//   - SNAP:   "# 주석", "U V [W]" (0부터 시작, 가중치 없으면 1)
+//   - 바이너리(.vag): 아래 BinaryGraphHeader + u[m], v[m], w[m] 열
+// 파일은 mmap으로 읽고, 간선 수를 먼저 센 뒤 열을 한 번에 할당 (간선별 할당 없음)
+
+#ifndef GRAPH_CSR_H
+#define GRAPH_CSR_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "graph_edges.h"
+
+// ============================================================================
+// 1. CSR 인접 구조
+// ============================================================================
+// 무방향 간선 하나가 양쪽 정점에 한 번씩 들어감 (슬롯 2m개)
+// edgeIds[k]는 슬롯 k가 가리키는 EdgeList 인덱스
+
+struct CsrGraph {
+  uint32_t nodeCount = 0;
+  std::vector<uint64_t> offsets; // nodeCount + 1
+  std::vector<uint32_t> targets;
+  std::vector<int32_t> weights;
+  std::vector<uint32_t> edgeIds;
+
+  uint64_t begin(uint32_t v) const { return offsets[v]; }
+  uint64_t end(uint32_t v) const { return offsets[v + 1]; }
+  uint32_t degree(uint32_t v) const {
+    return (uint32_t)(offsets[v + 1] - offsets[v]);
+  }
+};
+
+// 차수 세기 -> 누적합 -> 채우기 (counting sort와 같은 방식)
+inline void buildCsr(const EdgeList &edges, CsrGraph &g) {
+  const uint32_t n = edges.nodeCount;
+  const size_t m = edges.size();
+  g.nodeCount = n;
+  g.offsets.assign((size_t)n + 1, 0);
+  for (size_t i = 0; i < m; i++) {
+    g.offsets[edges.u[i] + 1]++;
+    g.offsets[edges.v[i] + 1]++;
+  }
+  for (uint32_t v = 0; v < n; v++)
+    g.offsets[v + 1] += g.offsets[v];
+
+  g.targets.resize(2 * m);
+  g.weights.resize(2 * m);
+  g.edgeIds.resize(2 * m);
+  std::vector<uint64_t> cursor(g.offsets.begin(), g.offsets.end() - 1);
+  for (size_t i = 0; i < m; i++) {
+    uint32_t a = edges.u[i], b = edges.v[i];
+    uint64_t k = cursor[a]++;
+    g.targets[k] = b;
+    g.weights[k] = edges.w[i];
+    g.edgeIds[k] = (uint32_t)i;
+    k = cursor[b]++;
+    g.targets[k] = a;
+    g.weights[k] = edges.w[i];
+    g.edgeIds[k] = (uint32_t)i;
+  }
+}
+
+// ============================================================================
+// 2. mmap 파일
+// ============================================================================
+
+struct MappedFile {
+  const char *data = nullptr;
+  size_t size = 0;
+  int fd = -1;
+
+  bool open(const char *path) {
+    fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+      return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      close();
+      return false;
+    }
+    size = (size_t)st.st_size;
+    if (size == 0)
+      return true;
+    void *p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) {
+      close();
+      return false;
+    }
+    madvise(p, size, MADV_SEQUENTIAL);
+    data = (const char *)p;
+    return true;
+  }
+
+  void close() {
+    if (data)
+      munmap((void *)data, size);
+    if (fd >= 0)
+      ::close(fd);
+    data = nullptr;
+    size = 0;
+    fd = -1;
+  }
+
+  ~MappedFile() { close(); }
+};
+
+// ============================================================================
+// 3. 바이너리 형식
+// ============================================================================
+
+#define BINARY_GRAPH_MAGIC "VAGRAPH"
+#define BINARY_GRAPH_VERSION 1
+
+struct BinaryGraphHeader {
+  char magic[8];      // "VAGRAPH\0"
+  uint32_t version;   // BINARY_GRAPH_VERSION
+  uint32_t flags;     // 예약 (0)
+  uint64_t nodeCount;
+  uint64_t edgeCount; // 뒤따르는 u[m](uint32), v[m](uint32), w[m](int32)
+};
+
+inline bool isBinaryGraph(const MappedFile &f) {
+  return f.size >= sizeof(BinaryGraphHeader) &&
+         std::memcmp(f.data, BINARY_GRAPH_MAGIC, 8) == 0;
+}
+
+inline bool parseBinaryGraph(const MappedFile &f, EdgeList &edges) {
+  BinaryGraphHeader h;
+  std::memcpy(&h, f.data, sizeof(h));
+  // 곱하기 전에 범위 확인 (edgeCount x 12가 넘치면 크기 비교가 무의미)
+  if (h.version != BINARY_GRAPH_VERSION || h.nodeCount > UINT32_MAX ||
+      h.edgeCount > (f.size - sizeof(h)) / (3 * sizeof(uint32_t))) {
+    std::fprintf(stderr, "binary graph: bad header or truncated file\n");
+    return false;
+  }
+  const size_t m = (size_t)h.edgeCount;
+  edges.nodeCount = (uint32_t)h.nodeCount;
+  edges.resize(m);
+  const char *p = f.data + sizeof(h);
+  std::memcpy(edges.u.data(), p, m * sizeof(uint32_t));
+  std::memcpy(edges.v.data(), p + m * sizeof(uint32_t), m * sizeof(uint32_t));
+  std::memcpy(edges.w.data(), p + 2 * m * sizeof(uint32_t),
+              m * sizeof(int32_t));
+  for (size_t i = 0; i < m; i++) {
+    if (edges.u[i] >= edges.nodeCount || edges.v[i] >= edges.nodeCount) {
+      std::fprintf(stderr, "binary graph: edge %zu out of range\n", i);
+      return false;
+    }
+  }
+  return true;
+}
+
+inline bool writeBinaryGraph(const char *path, const EdgeList &edges) {
+  FILE *out = std::fopen(path, "wb");
+  if (!out)
+    return false;
+  BinaryGraphHeader h;
+  std::memset(&h, 0, sizeof(h));
+  std::memcpy(h.magic, BINARY_GRAPH_MAGIC, 8);
+  h.version = BINARY_GRAPH_VERSION;
+  h.nodeCount = edges.nodeCount;
+  h.edgeCount = edges.size();
+  const size_t m = edges.size();
+  bool ok = std::fwrite(&h, sizeof(h), 1, out) == 1 &&
+            std::fwrite(edges.u.data(), sizeof(uint32_t), m, out) == m &&
+            std::fwrite(edges.v.data(), sizeof(uint32_t), m, out) == m &&
+            std::fwrite(edges.w.data(), sizeof(int32_t), m, out) == m;
+  return std::fclose(out) == 0 && ok;
+}
+
+// ============================================================================
+// 4. 텍스트 형식 (DIMACS / SNAP)
+// ============================================================================
+
+// 줄 안의 공백 (CRLF 파일의 '\r' 포함). 간선 줄 세기와 채우기가 같이 씀
+inline bool isTextBlank(char ch) { return ch == ' ' || ch == '\t' || ch == '\r'; }
+
+// 공백을 건너뛴 줄 첫 글자로 간선 줄인지 판단
+inline bool isEdgeLead(bool dimacs, char lead) {
+  return dimacs ? (lead == 'a' || lead == 'e') : (lead >= '0' && lead <= '9');
+}
+
+struct TextCursor {
+  const char *p;
+  const char *end;
+
+  void skipBlanks() {
+    while (p < end && isTextBlank(*p))
+      p++;
+  }
+  void skipLine() {
+    while (p < end && *p != '\n')
+      p++;
+    if (p < end)
+      p++;
+  }
+  bool atLineEnd() {
+    skipBlanks();
+    return p >= end || *p == '\n';
+  }
+  bool readInt(int64_t &value) {
+    skipBlanks();
+    bool negative = false;
+    if (p < end && *p == '-') {
+      negative = true;
+      p++;
+    }
+    if (p >= end || *p < '0' || *p > '9')
+      return false;
+    int64_t x = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+      if (x > (INT64_MAX - 9) / 10)
+        return false; // 자릿수 초과
+      x = x * 10 + (*p++ - '0');
+    }
+    value = negative ? -x : x;
+    // 정수 뒤에 바로 다른 글자가 오면 ("3.5", "12abc") 정수가 아님
+    return p >= end || *p == '\n' || isTextBlank(*p);
+  }
+};
+
+// 줄 첫 글자로 형식 판단: 'c'/'p'/'a'/'e'면 DIMACS, 그 외 SNAP
+inline bool isDimacsText(const MappedFile &f) {
+  TextCursor c{f.data, f.data + f.size};
+  while (c.p < c.end) {
+    c.skipBlanks();
+    if (c.p < c.end && *c.p != '\n' && *c.p != '#')
+      return *c.p == 'c' || *c.p == 'p' || *c.p == 'a' || *c.p == 'e';
+    c.skipLine();
+  }
+  return false;
+}
+
+// 두 번 훑음: 1) 간선 줄 수 세기 2) 미리 할당한 열에 채우기
+inline bool parseTextGraph(const MappedFile &f, EdgeList &edges) {
+  const bool dimacs = isDimacsText(f);
+  const int64_t base = dimacs ? 1 : 0;
+
+  size_t lines = 0;
+  for (const char *p = f.data, *end = f.data + f.size; p < end;) {
+    const char *q = p;
+    while (q < end && isTextBlank(*q))
+      q++;
+    if (q < end && isEdgeLead(dimacs, *q))
+      lines++;
+    const char *nl = (const char *)std::memchr(q, '\n', end - q);
+    p = nl ? nl + 1 : end;
+  }
+  edges.resize(lines);
+
+  TextCursor c{f.data, f.data + f.size};
+  size_t m = 0;
+  int64_t maxId = -1;
+  int64_t declaredNodes = 0;
+  size_t lineNo = 0;
+  while (c.p < c.end) {
+    lineNo++;
+    c.skipBlanks();
+    if (c.p >= c.end)
+      break;
+    char lead = *c.p;
+    if (dimacs && lead == 'p') {
+      c.p++;
+      c.skipBlanks();
+      while (c.p < c.end && *c.p != ' ' && *c.p != '\t')
+        c.p++; // 문제 종류 (sp, edge 등)
+      if (c.readInt(declaredNodes) && declaredNodes > UINT32_MAX) {
+        std::fprintf(stderr, "graph: node count too large at line %zu\n",
+                     lineNo);
+        return false;
+      }
+      c.skipLine();
+      continue;
+    }
+    if (!isEdgeLead(dimacs, lead)) {
+      c.skipLine();
+      continue;
+    }
+    if (m >= lines) { // 세기와 채우기가 어긋나면 열 밖에 쓰지 않고 실패
+      std::fprintf(stderr, "graph: edge count mismatch at line %zu\n", lineNo);
+      return false;
+    }
+    if (dimacs)
+      c.p++;
+
+    // 정점 번호는 nodeCount = maxId + 1이 uint32_t에 들어가야 함
+    int64_t a, b, w = 1;
+    if (!c.readInt(a) || !c.readInt(b) || a < base || b < base ||
+        a - base >= (int64_t)UINT32_MAX || b - base >= (int64_t)UINT32_MAX) {
+      std::fprintf(stderr, "graph: parse error at line %zu\n", lineNo);
+      return false;
+    }
+    if (!c.atLineEnd() &&
+        (!c.readInt(w) || w < INT32_MIN || w > INT32_MAX)) {
+      std::fprintf(stderr, "graph: bad weight at line %zu\n", lineNo);
+      return false;
+    }
+    a -= base;
+    b -= base;
+    if (a > maxId)
+      maxId = a;
+    if (b > maxId)
+      maxId = b;
+    edges.u[m] = (uint32_t)a;
+    edges.v[m] = (uint32_t)b;
+    edges.w[m] = (int32_t)w;
+    m++;
+    c.skipLine();
+  }
+
+  edges.nodeCount = (uint32_t)(declaredNodes > maxId + 1 ? declaredNodes
+                                                         : maxId + 1);
+  return true;
+}
+
+// ============================================================================
+// 5. 진입점
+// ============================================================================
+
+inline bool loadGraph(const char *path, EdgeList &edges) {
+  MappedFile f;
+  if (!f.open(path)) {
+    std::fprintf(stderr, "graph: cannot open %s\n", path);
+    return false;
+  }
+  edges.clear();
+  if (isBinaryGraph(f))
+    return parseBinaryGraph(f, edges);
+  return parseTextGraph(f, edges);
+}
+
+inline bool loadGraph(const char *path, EdgeList &edges, CsrGraph &g) {
+  if (!loadGraph(path, edges))
+    return false;
+  buildCsr(edges, g);
+  return true;
+}
+
+#endif
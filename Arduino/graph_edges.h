@@ -0,0 +1,308 @@
+// 간선 목록 (Structure-of-Arrays) 및 간선 정렬 단계 - PC 전용
+// graph_kruskal.cpp 등에서 큰 그래프를 헤드리스로 돌릴 때 사용
+// 정렬은 모두 "가중치 오름차순, 같은 가중치는 원래 순서" (버블 소트와 같은 의미)
+
+#ifndef GRAPH_EDGES_H
+#define GRAPH_EDGES_H
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// 1. 간선 목록
+// ============================================================================
+
+struct EdgeList {
+  uint32_t nodeCount = 0;
+  std::vector<uint32_t> u;
+  std::vector<uint32_t> v;
+  std::vector<int32_t> w;
+
+  size_t size() const { return w.size(); }
+
+  void reserve(size_t m) {
+    u.reserve(m);
+    v.reserve(m);
+    w.reserve(m);
+  }
+
+  void resize(size_t m) {
+    u.resize(m);
+    v.resize(m);
+    w.resize(m);
+  }
+
+  void add(uint32_t a, uint32_t b, int32_t weight) {
+    u.push_back(a);
+    v.push_back(b);
+    w.push_back(weight);
+  }
+
+  void clear() {
+    u.clear();
+    v.clear();
+    w.clear();
+  }
+};
+
+// 열 하나를 perm 순서로 재배치 (임시 버퍼 하나만 사용)
+template <typename T>
+void gatherColumn(std::vector<T> &column, const std::vector<uint32_t> &perm,
+                  std::vector<T> &scratch) {
+  scratch.resize(perm.size());
+  for (size_t i = 0; i < perm.size(); i++)
+    scratch[i] = column[perm[i]];
+  column.swap(scratch);
+}
+
+// perm[i]번 간선이 i번 자리로 오도록 재배치
+inline void applyPermutation(EdgeList &edges,
+                             const std::vector<uint32_t> &perm) {
+  std::vector<uint32_t> scratch;
+  gatherColumn(edges.u, perm, scratch);
+  gatherColumn(edges.v, perm, scratch);
+  std::vector<int32_t> weightScratch;
+  gatherColumn(edges.w, perm, weightScratch);
+}
+
+// ============================================================================
+// 2. LSD radix sort (정수 가중치)
+// ============================================================================
+
+// 부호 있는 가중치 -> 순서를 유지하는 부호 없는 키
+inline uint32_t weightKey(int32_t w) { return (uint32_t)w ^ 0x80000000u; }
+
+// 키 오름차순 안정 정렬 순열 (8bit x 4 pass)
+// 모든 키의 해당 바이트가 같으면 그 pass는 건너뜀 (작은 가중치는 1 pass)
+inline std::vector<uint32_t> radixSortPermutation(std::vector<uint32_t> keys) {
+  const size_t m = keys.size();
+  std::vector<uint32_t> perm(m), permNext(m), keysNext(m);
+  for (size_t i = 0; i < m; i++)
+    perm[i] = (uint32_t)i;
+
+  // 4개 자릿수의 히스토그램을 한 번에 계산
+  static const int DIGITS = 4;
+  std::vector<size_t> count(DIGITS * 256, 0);
+  for (size_t i = 0; i < m; i++) {
+    uint32_t k = keys[i];
+    for (int d = 0; d < DIGITS; d++)
+      count[d * 256 + ((k >> (d * 8)) & 0xFF)]++;
+  }
+
+  for (int d = 0; d < DIGITS; d++) {
+    size_t *bucket = &count[d * 256];
+    bool trivial = false;
+    for (int b = 0; b < 256; b++) {
+      if (bucket[b] == m) {
+        trivial = true;
+        break;
+      }
+    }
+    if (trivial)
+      continue;
+
+    size_t offset = 0;
+    for (int b = 0; b < 256; b++) {
+      size_t c = bucket[b];
+      bucket[b] = offset;
+      offset += c;
+    }
+
+    const int shift = d * 8;
+    for (size_t i = 0; i < m; i++) {
+      uint32_t k = keys[i];
+      size_t pos = bucket[(k >> shift) & 0xFF]++;
+      keysNext[pos] = k;
+      permNext[pos] = perm[i];
+    }
+    keys.swap(keysNext);
+    perm.swap(permNext);
+  }
+  return perm;
+}
+
+inline void radixSortEdges(EdgeList &edges) {
+  std::vector<uint32_t> keys(edges.size());
+  for (size_t i = 0; i < keys.size(); i++)
+    keys[i] = weightKey(edges.w[i]);
+  applyPermutation(edges, radixSortPermutation(std::move(keys)));
+}
+
+// ============================================================================
+// 3. Introsort (일반 키: 실수 거리, 복합 키 등)
+// ============================================================================
+// quicksort(중앙값 3개 피벗) + 깊이 한계 초과 시 heapsort + 작은 구간 insertion
+// (키, 원래 인덱스) 쌍을 비교하므로 같은 키는 원래 순서를 유지
+
+template <typename Key> struct KeyedIndex {
+  Key key;
+  uint32_t index;
+
+  bool operator<(const KeyedIndex &o) const {
+    return key < o.key || (!(o.key < key) && index < o.index);
+  }
+};
+
+template <typename T> void insertionSortRange(T *a, size_t lo, size_t hi) {
+  for (size_t i = lo + 1; i < hi; i++) {
+    T x = a[i];
+    size_t j = i;
+    while (j > lo && x < a[j - 1]) {
+      a[j] = a[j - 1];
+      j--;
+    }
+    a[j] = x;
+  }
+}
+
+template <typename T> void siftDown(T *a, size_t root, size_t n) {
+  while (true) {
+    size_t child = 2 * root + 1;
+    if (child >= n)
+      return;
+    if (child + 1 < n && a[child] < a[child + 1])
+      child++;
+    if (!(a[root] < a[child]))
+      return;
+    std::swap(a[root], a[child]);
+    root = child;
+  }
+}
+
+template <typename T> void heapSortRange(T *a, size_t n) {
+  for (size_t i = n / 2; i-- > 0;)
+    siftDown(a, i, n);
+  for (size_t end = n; end-- > 1;) {
+    std::swap(a[0], a[end]);
+    siftDown(a, 0, end);
+  }
+}
+
+// a[lo, hi)를 중앙값 3개 피벗으로 Hoare 분할, 피벗의 최종 위치 j를 반환
+// (a[lo, j) <= a[j] <= a[j+1, hi))
+template <typename T> size_t partitionRange(T *a, size_t lo, size_t hi) {
+  size_t mid = lo + (hi - lo) / 2;
+  size_t last = hi - 1;
+  if (a[mid] < a[lo])
+    std::swap(a[mid], a[lo]);
+  if (a[last] < a[lo])
+    std::swap(a[last], a[lo]);
+  if (a[last] < a[mid])
+    std::swap(a[last], a[mid]);
+  std::swap(a[lo], a[mid]);
+  const T pivot = a[lo];
+
+  size_t i = lo, j = hi;
+  while (true) {
+    do
+      i++;
+    while (i < hi && a[i] < pivot);
+    do
+      j--;
+    while (pivot < a[j]);
+    if (i >= j)
+      break;
+    std::swap(a[i], a[j]);
+  }
+  std::swap(a[lo], a[j]);
+  return j;
+}
+
+template <typename T> void introSortLoop(T *a, size_t lo, size_t hi, int depth) {
+  static const size_t INSERTION_THRESHOLD = 16;
+  while (hi - lo > INSERTION_THRESHOLD) {
+    if (depth-- == 0) {
+      heapSortRange(a + lo, hi - lo);
+      return;
+    }
+    size_t j = partitionRange(a, lo, hi);
+
+    // 작은 쪽은 재귀, 큰 쪽은 반복 (스택 깊이 O(log n))
+    if (j - lo < hi - j - 1) {
+      introSortLoop(a, lo, j, depth);
+      lo = j + 1;
+    } else {
+      introSortLoop(a, j + 1, hi, depth);
+      hi = j;
+    }
+  }
+  insertionSortRange(a, lo, hi);
+}
+
+template <typename T> void introSort(T *a, size_t n) {
+  int depth = 0;
+  for (size_t k = n; k > 1; k >>= 1)
+    depth += 2;
+  introSortLoop(a, 0, n, depth);
+}
+
+// keys[i]는 i번 간선의 정렬 키
+template <typename Key>
+void introSortEdges(EdgeList &edges, const std::vector<Key> &keys) {
+  std::vector<KeyedIndex<Key>> items(edges.size());
+  for (size_t i = 0; i < items.size(); i++) {
+    items[i].key = keys[i];
+    items[i].index = (uint32_t)i;
+  }
+  introSort(items.data(), items.size());
+
+  std::vector<uint32_t> perm(items.size());
+  for (size_t i = 0; i < items.size(); i++)
+    perm[i] = items[i].index;
+  std::vector<KeyedIndex<Key>>().swap(items);
+  applyPermutation(edges, perm);
+}
+
+// ============================================================================
+// 4. 점진 정렬 (incremental quicksort)
+// ============================================================================
+// next()를 부를 때마다 다음으로 작은 원소를 돌려줌. 필요한 앞부분만 분할하고
+// 아직 보지 않은 뒷부분은 분할된 덩어리로 남겨 둠
+// 앞의 k개를 꺼내는 비용은 기대 O(m + k log k) (전체 정렬은 O(m log m))
+// bounds_: 피벗 위치 스택 (위로 갈수록 작음). a[next_, top) <= a[top]
+
+template <typename T> class IncrementalSorter {
+public:
+  IncrementalSorter(T *a, size_t n) : a_(a), n_(n), next_(0), sortedEnd_(0) {
+    bounds_.push_back(n);
+  }
+
+  bool done() const { return next_ >= n_; }
+
+  const T &next() {
+    if (next_ == sortedEnd_)
+      settle();
+    return a_[next_++];
+  }
+
+  // 최종 위치가 확정된 원소 수 (꺼낸 것 + 정렬만 된 것)
+  size_t sorted() const { return sortedEnd_; }
+
+private:
+  void settle() {
+    static const size_t INSERTION_THRESHOLD = 16;
+    while (true) {
+      const size_t hi = bounds_.back();
+      if (hi - next_ <= INSERTION_THRESHOLD) {
+        insertionSortRange(a_, next_, hi);
+        sortedEnd_ = hi < n_ ? hi + 1 : hi; // 피벗 자신도 확정
+        bounds_.pop_back();
+        return;
+      }
+      bounds_.push_back(partitionRange(a_, next_, hi));
+    }
+  }
+
+  T *a_;
+  size_t n_;
+  size_t next_;
+  size_t sortedEnd_;
+  std::vector<size_t> bounds_;
+};
+
+// 정수 가중치 기본 정렬 단계
+inline void sortEdgesByWeight(EdgeList &edges) { radixSortEdges(edges); }
+
+#endif
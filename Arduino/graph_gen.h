@@ -0,0 +1,347 @@
+// 그래프 생성기 - PC 전용 (벤치마크 입력)
+// 모든 생성기는 seed가 같으면 같은 그래프를 만듦 (splitmix64)
+//   - generateGeometric: 정사각형 위 무작위 점, 반지름 r 안의 쌍을 연결
+//                        가중치 = 유클리드 거리 반올림 (데모 nodes[] 표와 같은 규칙)
+//                        칸 행 띠별로 멀티스레드, writeGeometricGraph()는 .vag로 바로 씀
+//   - generateGrid:      w x h 격자, 상하좌우 이웃, 무작위 가중치
+//   - generatePowerLaw:  Barabási–Albert 선호 연결 (차수 분포 ~ k^-3)
+//   - generateComplete:  완전 그래프, 가중치 종류를 적게 해서 같은 가중치가 많음
+
+#ifndef GRAPH_GEN_H
+#define GRAPH_GEN_H
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "graph_csr.h"
+#include "graph_edges.h"
+
+#define GEN_SIDE 32768 // 기하 그래프 좌표 범위 0..GEN_SIDE-1 (emst.h와 같음)
+
+struct GenRng {
+  uint64_t state;
+  explicit GenRng(uint64_t seed) : state(seed) {}
+  uint64_t next() {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+  uint32_t below(uint32_t bound) {
+    return (uint32_t)(((next() >> 32) * bound) >> 32);
+  }
+};
+
+// ============================================================================
+// 1. 무작위 기하 그래프
+// ============================================================================
+// 평균 차수가 avgDegree가 되도록 r = side * sqrt(avgDegree / (pi * n))
+// 한 변이 r인 칸으로 나눠 같은 칸과 이웃 칸만 비교 (기대 O(n + m))
+// 간선 찾기는 칸 행을 띠(stripe)로 나눠 스레드마다 하나씩 (점/칸 표는 읽기만)
+// 띠 결과를 띠 순서로 이으므로 스레드 수와 상관없이 같은 간선 순서
+
+#define GEN_STRIPES_PER_THREAD 4 // 띠마다 점 수가 달라도 스레드가 고르게 끝나도록
+#define GEN_WRITE_BATCH 65536    // 파일로 쓸 때 띠마다 모아 쓰는 간선 수
+
+struct GeometricGrid {
+  std::vector<int32_t> x, y;
+  std::vector<uint32_t> start, order; // 칸별 점 목록 (counting sort)
+  uint32_t cells = 0;
+  double r = 1;
+  int64_t r2 = 1;
+
+  void build(uint32_t n, double avgDegree, uint64_t seed) {
+    GenRng rng(seed);
+    x.resize(n);
+    y.resize(n);
+    for (uint32_t i = 0; i < n; i++) {
+      x[i] = (int32_t)rng.below(GEN_SIDE);
+      y[i] = (int32_t)rng.below(GEN_SIDE);
+    }
+    r = GEN_SIDE * std::sqrt(avgDegree / (M_PI * (n ? n : 1)));
+    if (r < 1)
+      r = 1;
+    r2 = (int64_t)(r * r);
+    cells = (uint32_t)(GEN_SIDE / r) + 1;
+
+    start.assign((size_t)cells * cells + 1, 0);
+    order.resize(n);
+    std::vector<uint32_t> cellOf(n);
+    for (uint32_t i = 0; i < n; i++) {
+      cellOf[i] = (uint32_t)(y[i] / r) * cells + (uint32_t)(x[i] / r);
+      start[cellOf[i] + 1]++;
+    }
+    for (size_t c = 0; c + 1 < start.size(); c++)
+      start[c + 1] += start[c];
+    std::vector<uint32_t> fill(start.begin(), start.end() - 1);
+    for (uint32_t i = 0; i < n; i++)
+      order[fill[cellOf[i]]++] = i;
+  }
+
+  // 칸 행 [row0, row1)에서 시작하는 쌍 중 거리 r 이내를 emit(a, b, weight)
+  // 자기 칸 + 오른쪽/아래 방향 이웃 4칸 (각 쌍을 한 번만)
+  template <typename Emit>
+  void scanRows(uint32_t row0, uint32_t row1, Emit &&emit) const {
+    static const int dxs[5] = {0, 1, -1, 0, 1};
+    static const int dys[5] = {0, 0, 1, 1, 1};
+    for (uint32_t cy = row0; cy < row1; cy++) {
+      for (uint32_t cx = 0; cx < cells; cx++) {
+        const uint32_t c = cy * cells + cx;
+        for (int k = 0; k < 5; k++) {
+          int64_t nx = (int64_t)cx + dxs[k], ny = (int64_t)cy + dys[k];
+          if (nx < 0 || ny < 0 || nx >= cells || ny >= cells)
+            continue;
+          const uint32_t d = (uint32_t)ny * cells + (uint32_t)nx;
+          for (uint32_t i = start[c]; i < start[c + 1]; i++) {
+            const uint32_t a = order[i];
+            for (uint32_t j = (d == c ? i + 1 : start[d]); j < start[d + 1];
+                 j++) {
+              const uint32_t b = order[j];
+              int64_t dx = x[a] - x[b], dy = y[a] - y[b];
+              int64_t dist2 = dx * dx + dy * dy;
+              if (dist2 <= r2)
+                emit(a, b, (int32_t)std::lround(std::sqrt((double)dist2)));
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // 띠 s의 칸 행 범위 (행을 고르게 나눔)
+  void stripeRows(uint32_t s, uint32_t stripes, uint32_t &row0,
+                  uint32_t &row1) const {
+    row0 = (uint32_t)((uint64_t)cells * s / stripes);
+    row1 = (uint32_t)((uint64_t)cells * (s + 1) / stripes);
+  }
+};
+
+// 띠 stripes개를 threads개 스레드가 번호 순서대로 나눠 가짐 (body(stripe))
+template <typename Body>
+void forEachStripe(uint32_t stripes, unsigned threads, const Body &body) {
+  if (threads <= 1 || stripes <= 1) {
+    for (uint32_t s = 0; s < stripes; s++)
+      body(s);
+    return;
+  }
+  std::atomic<uint32_t> next(0);
+  std::vector<std::thread> pool;
+  for (unsigned t = 0; t < threads; t++) {
+    pool.emplace_back([&] {
+      for (uint32_t s; (s = next.fetch_add(1)) < stripes;)
+        body(s);
+    });
+  }
+  for (std::thread &th : pool)
+    th.join();
+}
+
+inline unsigned genThreads(unsigned threads) {
+  if (threads == 0)
+    threads = std::thread::hardware_concurrency();
+  return threads ? threads : 1;
+}
+
+// threads가 0이면 하드웨어 스레드 수 사용
+inline void generateGeometric(uint32_t n, double avgDegree, uint64_t seed,
+                              EdgeList &out, unsigned threads = 0) {
+  GeometricGrid grid;
+  grid.build(n, avgDegree, seed);
+  threads = genThreads(threads);
+  const uint32_t stripes = threads > 1 ? threads * GEN_STRIPES_PER_THREAD : 1;
+
+  std::vector<EdgeList> parts(stripes);
+  forEachStripe(stripes, threads, [&](uint32_t s) {
+    uint32_t row0, row1;
+    grid.stripeRows(s, stripes, row0, row1);
+    EdgeList &part = parts[s];
+    part.reserve((size_t)((double)n * (row1 - row0) / grid.cells * avgDegree /
+                          2 * 1.1));
+    grid.scanRows(row0, row1, [&part](uint32_t a, uint32_t b, int32_t w) {
+      part.add(a, b, w);
+    });
+  });
+
+  out.clear();
+  out.nodeCount = n;
+  size_t m = 0;
+  for (const EdgeList &part : parts)
+    m += part.size();
+  out.reserve(m);
+  for (EdgeList &part : parts) {
+    out.u.insert(out.u.end(), part.u.begin(), part.u.end());
+    out.v.insert(out.v.end(), part.v.begin(), part.v.end());
+    out.w.insert(out.w.end(), part.w.begin(), part.w.end());
+    EdgeList().u.swap(part.u); // 띠 버퍼는 바로 반납
+    EdgeList().v.swap(part.v);
+    EdgeList().w.swap(part.w);
+  }
+}
+
+// 바이너리 그래프(.vag, graph_csr.h)로 바로 씀. 간선 전체를 메모리에 올리지 않음
+//   1) 띠마다 간선 수만 셈 -> 띠별 파일 위치가 정해짐
+//   2) 띠마다 다시 훑으며 GEN_WRITE_BATCH개씩 u/v/w 열의 제자리에 pwrite
+// 결과는 generateGeometric() + writeBinaryGraph()와 같은 파일
+struct GeometricFileStats {
+  uint64_t edges = 0;
+  double radius = 0;
+  unsigned threads = 0;
+  double countMs = 0;
+  double writeMs = 0;
+};
+
+inline bool writeGeometricGraph(const char *path, uint32_t n, double avgDegree,
+                                uint64_t seed, GeometricFileStats &stats,
+                                unsigned threads = 0) {
+  using namespace std::chrono;
+  auto nowMs = [] {
+    return duration_cast<duration<double, std::milli>>(
+               steady_clock::now().time_since_epoch())
+        .count();
+  };
+  double t0 = nowMs();
+  GeometricGrid grid;
+  grid.build(n, avgDegree, seed);
+  threads = genThreads(threads);
+  const uint32_t stripes = threads > 1 ? threads * GEN_STRIPES_PER_THREAD : 1;
+
+  std::vector<uint64_t> first((size_t)stripes + 1, 0);
+  forEachStripe(stripes, threads, [&](uint32_t s) {
+    uint32_t row0, row1;
+    grid.stripeRows(s, stripes, row0, row1);
+    uint64_t count = 0;
+    grid.scanRows(row0, row1, [&count](uint32_t, uint32_t, int32_t) { count++; });
+    first[s + 1] = count;
+  });
+  for (uint32_t s = 0; s < stripes; s++)
+    first[s + 1] += first[s];
+  const uint64_t m = first[stripes];
+  double t1 = nowMs();
+
+  int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+    return false;
+  BinaryGraphHeader h;
+  std::memset(&h, 0, sizeof(h));
+  std::memcpy(h.magic, BINARY_GRAPH_MAGIC, 8);
+  h.version = BINARY_GRAPH_VERSION;
+  h.nodeCount = n;
+  h.edgeCount = m;
+  bool ok = ::pwrite(fd, &h, sizeof(h), 0) == (ssize_t)sizeof(h) &&
+            ::ftruncate(fd, (off_t)(sizeof(h) + m * 3 * sizeof(uint32_t))) == 0;
+
+  std::atomic<bool> failed(!ok);
+  forEachStripe(stripes, threads, [&](uint32_t s) {
+    uint32_t row0, row1;
+    grid.stripeRows(s, stripes, row0, row1);
+    EdgeList batch;
+    batch.reserve(GEN_WRITE_BATCH);
+    uint64_t at = first[s]; // 이 띠의 다음 간선 번호
+    auto flush = [&] {
+      const size_t k = batch.size();
+      const off_t base = (off_t)sizeof(h);
+      const ssize_t bytes = (ssize_t)(k * sizeof(uint32_t));
+      if (::pwrite(fd, batch.u.data(), bytes, base + (off_t)(at * 4)) != bytes ||
+          ::pwrite(fd, batch.v.data(), bytes, base + (off_t)((m + at) * 4)) !=
+              bytes ||
+          ::pwrite(fd, batch.w.data(), bytes,
+                   base + (off_t)((2 * m + at) * 4)) != bytes)
+        failed = true;
+      at += k;
+      batch.clear();
+    };
+    grid.scanRows(row0, row1, [&](uint32_t a, uint32_t b, int32_t w) {
+      batch.add(a, b, w);
+      if (batch.size() == GEN_WRITE_BATCH)
+        flush();
+    });
+    if (batch.size())
+      flush();
+  });
+  ok = ::close(fd) == 0 && !failed;
+
+  stats.edges = m;
+  stats.radius = grid.r;
+  stats.threads = threads;
+  stats.countMs = t1 - t0;
+  stats.writeMs = nowMs() - t1;
+  return ok;
+}
+
+// ============================================================================
+// 2. 격자 그래프
+// ============================================================================
+
+inline void generateGrid(uint32_t width, uint32_t height, int32_t maxWeight,
+                         uint64_t seed, EdgeList &out) {
+  GenRng rng(seed);
+  out.clear();
+  out.nodeCount = width * height;
+  out.reserve((size_t)2 * width * height);
+  for (uint32_t y = 0; y < height; y++) {
+    for (uint32_t x = 0; x < width; x++) {
+      const uint32_t v = y * width + x;
+      if (x + 1 < width)
+        out.add(v, v + 1, (int32_t)rng.below((uint32_t)maxWeight) + 1);
+      if (y + 1 < height)
+        out.add(v, v + width, (int32_t)rng.below((uint32_t)maxWeight) + 1);
+    }
+  }
+}
+
+// ============================================================================
+// 3. 멱법칙(power-law) 그래프
+// ============================================================================
+// 새 정점마다 기존 간선 끝점 목록에서 무작위로 perNode개를 골라 연결
+// (끝점 목록에 차수만큼 들어 있으므로 차수에 비례한 선택)
+
+inline void generatePowerLaw(uint32_t n, uint32_t perNode, int32_t maxWeight,
+                             uint64_t seed, EdgeList &out) {
+  GenRng rng(seed);
+  out.clear();
+  out.nodeCount = n;
+  out.reserve((size_t)n * perNode);
+  std::vector<uint32_t> endpoints;
+  endpoints.reserve((size_t)2 * n * perNode);
+  const uint32_t core = perNode + 1 < n ? perNode + 1 : n;
+  for (uint32_t a = 0; a < core; a++) {
+    for (uint32_t b = a + 1; b < core; b++) {
+      out.add(a, b, (int32_t)rng.below((uint32_t)maxWeight) + 1);
+      endpoints.push_back(a);
+      endpoints.push_back(b);
+    }
+  }
+  for (uint32_t v = core; v < n; v++) {
+    for (uint32_t k = 0; k < perNode; k++) {
+      uint32_t t = endpoints[rng.below((uint32_t)endpoints.size())];
+      out.add(v, t, (int32_t)rng.below((uint32_t)maxWeight) + 1);
+      endpoints.push_back(t);
+    }
+    for (uint32_t k = 0; k < perNode; k++)
+      endpoints.push_back(v);
+  }
+}
+
+// ============================================================================
+// 4. 완전 그래프 (중복 가중치)
+// ============================================================================
+// 가중치 1..distinctWeights (간선 수보다 훨씬 적게 주면 같은 가중치가 많이 생김)
+
+inline void generateComplete(uint32_t n, uint32_t distinctWeights,
+                             uint64_t seed, EdgeList &out) {
+  GenRng rng(seed);
+  out.clear();
+  out.nodeCount = n;
+  out.reserve((size_t)n * (n - 1) / 2);
+  for (uint32_t a = 0; a < n; a++) {
+    for (uint32_t b = a + 1; b < n; b++)
+      out.add(a, b, (int32_t)rng.below(distinctWeights) + 1);
+  }
+}
+
+#endif
@@ -0,0 +1,169 @@
+// 큰 그래프용 LED 히트맵 - PC 전용
+// 노드가 LED 수보다 훨씬 많으면 노드 하나에 픽셀 하나를 줄 수 없으므로
+// 배치 좌표(graph_layout.h 또는 점 좌표)로 노드를 width x height 칸에 모으고
+// 칸마다 "진행된 비율"을 밝기로 보여줌
+//   - 정점 모드: 처리된(트리에 들어간) 정점 수 / 칸의 정점 수      (Prim)
+//   - 간선 모드: 채택된 트리 간선의 끝점 수 / (2 x 칸의 정점 수)   (Kruskal)
+//                신장 트리의 차수 합은 2(V-1)이므로 끝나면 거의 가득 참
+// 비율의 분모가 칸마다 미리 정해지므로 이벤트 하나는 그 칸의 단계만 바꿀 수 있음
+//   -> 이벤트당 O(1) (다음 단계 문턱과 비교), 단계가 바뀐 칸만 dirty 목록에 넣고
+//      flush()는 그 칸만 다시 칠함. 프레임 비용 O(바뀐 칸), O(V) 아님
+
+#ifndef GRAPH_HEATMAP_H
+#define GRAPH_HEATMAP_H
+
+#include <cstdint>
+#include <vector>
+
+#include "graph_layout.h"
+
+#define HEAT_LEVELS 16
+#define HEAT_FRAMES 64                 // 헤드리스 히트맵 애니메이션의 목표 프레임 수
+#define HEAT_LAYOUT_WORK 4000000ULL    // 배치 예산 (노드 x 반복)
+#define HEAT_LAYOUT_MIN_ITERATIONS 20  // 이보다 적으면 힘 반복 없이 BFS/Hilbert 시작 위치만
+#define HEAT_LAYOUT_CANVAS 1024        // 배치 좌표 범위 (칸으로 모으기 전)
+
+// 단계별 색 (0: 노드는 있지만 아직 진행 없음 -> 어두운 파랑, 마지막: 흰색에 가까운 노랑)
+static const uint8_t heatPalette[HEAT_LEVELS][3] = {
+    {0, 0, 24},     {16, 0, 40},    {32, 0, 56},    {56, 0, 64},
+    {80, 0, 64},    {104, 0, 56},   {128, 0, 48},   {152, 8, 32},
+    {176, 24, 16},  {200, 48, 0},   {216, 80, 0},   {232, 112, 0},
+    {240, 152, 0},  {248, 192, 16}, {252, 224, 64}, {255, 255, 128}};
+
+struct HeatStats {
+  uint64_t events = 0;  // addNode/addEdge 호출 수
+  uint32_t frames = 0;  // flush 횟수
+  uint64_t repaints = 0; // flush로 다시 칠한 칸 수 (합계)
+  uint32_t occupied = 0; // 노드가 하나라도 있는 칸 수
+};
+
+class LedHeatmap {
+public:
+  LedHeatmap(int width, int height)
+      : width_(width), height_(height), cells_((uint32_t)(width * height)) {}
+
+  // 노드 좌표(임의 범위)를 경계 상자 기준으로 칸에 모음
+  // edgeMode면 칸의 분모가 정점 수 x 2 (트리 간선 끝점)
+  void bind(const std::vector<int32_t> &x, const std::vector<int32_t> &y,
+            bool edgeMode) {
+    const uint32_t n = (uint32_t)x.size();
+    cellOf_.assign(n, 0);
+    capacity_.assign(cells_, 0);
+    count_.assign(cells_, 0);
+    level_.assign(cells_, 0);
+    nextAt_.assign(cells_, UINT32_MAX);
+    dirtyFlag_.assign(cells_, 0);
+    dirty_.clear();
+    stats_ = HeatStats();
+    if (n == 0)
+      return;
+
+    int32_t minX = x[0], maxX = x[0], minY = y[0], maxY = y[0];
+    for (uint32_t v = 1; v < n; v++) {
+      minX = x[v] < minX ? x[v] : minX;
+      maxX = x[v] > maxX ? x[v] : maxX;
+      minY = y[v] < minY ? y[v] : minY;
+      maxY = y[v] > maxY ? y[v] : maxY;
+    }
+    const int64_t spanX = (int64_t)maxX - minX + 1, spanY = (int64_t)maxY - minY + 1;
+    const uint32_t perNode = edgeMode ? 2 : 1;
+    for (uint32_t v = 0; v < n; v++) {
+      const uint32_t cx = (uint32_t)(((int64_t)x[v] - minX) * width_ / spanX);
+      const uint32_t cy = (uint32_t)(((int64_t)y[v] - minY) * height_ / spanY);
+      cellOf_[v] = (uint16_t)(cy * width_ + cx);
+      capacity_[cellOf_[v]] += perNode;
+    }
+    for (uint32_t c = 0; c < cells_; c++) {
+      if (capacity_[c] == 0)
+        continue;
+      stats_.occupied++;
+      nextAt_[c] = threshold(c, 1);
+      markDirty(c); // 첫 flush에서 노드가 있는 칸을 모두 칠함 (그래프 윤곽)
+    }
+  }
+
+  // 정점 하나 처리됨
+  void addNode(uint32_t v) {
+    stats_.events++;
+    bump(cellOf_[v]);
+  }
+
+  // 트리 간선 하나 채택됨 (두 끝점의 칸에 하나씩)
+  void addEdge(uint32_t a, uint32_t b) {
+    stats_.events++;
+    bump(cellOf_[a]);
+    bump(cellOf_[b]);
+  }
+
+  // 단계가 바뀐 칸만 paint(x, y, r, g, b)로 다시 칠함. 칠한 칸 수를 돌려줌
+  template <typename Paint> uint32_t flush(Paint &&paint) {
+    const uint32_t painted = (uint32_t)dirty_.size();
+    for (uint32_t c : dirty_) {
+      dirtyFlag_[c] = 0;
+      const uint8_t *rgb = heatPalette[level_[c]];
+      paint((int)(c % width_), (int)(c / width_), rgb[0], rgb[1], rgb[2]);
+    }
+    dirty_.clear();
+    stats_.frames++;
+    stats_.repaints += painted;
+    return painted;
+  }
+
+  bool pending() const { return !dirty_.empty(); }
+  uint8_t level(int x, int y) const { return level_[(uint32_t)(y * width_ + x)]; }
+  const HeatStats &stats() const { return stats_; }
+
+private:
+  // 단계 L에 들어가는 개수: ceil(L x capacity / (HEAT_LEVELS - 1))
+  uint32_t threshold(uint32_t c, uint32_t lv) const {
+    if (lv >= HEAT_LEVELS)
+      return UINT32_MAX;
+    return (uint32_t)(((uint64_t)lv * capacity_[c] + HEAT_LEVELS - 2) /
+                      (HEAT_LEVELS - 1));
+  }
+
+  void bump(uint32_t c) {
+    if (++count_[c] < nextAt_[c])
+      return;
+    uint32_t lv = level_[c];
+    while (lv + 1 < HEAT_LEVELS && count_[c] >= threshold(c, lv + 1))
+      lv++;
+    level_[c] = (uint8_t)lv;
+    nextAt_[c] = threshold(c, lv + 1);
+    markDirty(c);
+  }
+
+  void markDirty(uint32_t c) {
+    if (dirtyFlag_[c])
+      return;
+    dirtyFlag_[c] = 1;
+    dirty_.push_back(c);
+  }
+
+  const int width_, height_;
+  const uint32_t cells_;
+  std::vector<uint16_t> cellOf_;   // 노드 -> 칸 (LED 행렬은 65536칸 미만)
+  std::vector<uint32_t> capacity_; // 칸별 분모
+  std::vector<uint32_t> count_;
+  std::vector<uint8_t> level_;
+  std::vector<uint32_t> nextAt_;   // 다음 단계로 올라가는 개수
+  std::vector<uint8_t> dirtyFlag_;
+  std::vector<uint32_t> dirty_;    // 마지막 flush 이후 단계가 바뀐 칸
+  HeatStats stats_;
+};
+
+// 좌표 없는 그래프: 예산 안에서 힘 기반 배치 (큰 그래프는 BFS/Hilbert 시작 위치만)
+// 칸으로 모을 것이므로 충돌 해소 없이 연속 좌표를 반올림
+inline uint32_t heatmapLayout(const EdgeList &graph, LedLayout &out) {
+  uint64_t iterations = graph.nodeCount ? HEAT_LAYOUT_WORK / graph.nodeCount : 0;
+  if (iterations > LAYOUT_ITERATIONS)
+    iterations = LAYOUT_ITERATIONS;
+  if (iterations < HEAT_LAYOUT_MIN_ITERATIONS)
+    iterations = 0;
+  GraphLayout layout(graph, HEAT_LAYOUT_CANVAS, HEAT_LAYOUT_CANVAS);
+  LayoutStats stats;
+  layout.runCoarse(out, stats, (uint32_t)iterations);
+  return stats.iterations;
+}
+
+#endif
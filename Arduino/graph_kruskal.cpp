@@ -6,9 +6,21 @@
 #include <chrono>
 #include <cmath>
 #include <cstdint>
+#include <cerrno>
 #include <cstdio>
 #include <math.h>
 #include <thread>
+#include <time.h>
+
+#include "disjoint_set.h"
+#include "edge_table.h"
+#include "emst.h"        // --emst 유클리드 MST
+#include "external_kruskal.h" // --external 외부 메모리 모드
+#include "graph_csr.h"   // --graph 헤드리스 모드
+#include "graph_heatmap.h" // --heatmap 큰 그래프 진행 히트맵
+#include "graph_layout.h" // --show 좌표 없는 그래프 배치
+#include "mst_engines.h"
+#include "mst_verify.h"   // --verify 결과 트리 검증
 
 #define F(x) x
 #define HEX 16
@@ -26,6 +38,24 @@ void delayMicroseconds(int us) {
   std::this_thread::sleep_for(std::chrono::microseconds(us));
 }
 
+// 단조 시계 (clock_nanosleep TIMER_ABSTIME과 같은 CLOCK_MONOTONIC 기준)
+struct timespec monotonicOrigin() {
+  static struct timespec origin = [] {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts;
+  }();
+  return origin;
+}
+
+unsigned long micros() {
+  struct timespec origin = monotonicOrigin();
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (unsigned long)((long long)(now.tv_sec - origin.tv_sec) * 1000000LL +
+                         (now.tv_nsec - origin.tv_nsec) / 1000);
+}
+
 void pinMode(int pin, int mode) {}
 void digitalWrite(int pin, int value) {}
 int digitalRead(int pin) { return HIGH; }
@@ -41,6 +71,7 @@ struct SerialType {
   void begin(unsigned long) {}
   void print(const char *s) { std::printf("%s", s); }
   void print(int v) { std::printf("%d", v); }
+  void print(unsigned long v) { std::printf("%lu", v); }
   void print(uint8_t v, int base) {
     if (base == HEX)
       std::printf("%x", v); // Arduino prints without leading zeros
@@ -59,6 +90,10 @@ struct SerialType {
     std::printf("%d\n", v);
     std::fflush(stdout);
   }
+  void println(unsigned long v) {
+    std::printf("%lu\n", v);
+    std::fflush(stdout);
+  }
   int available() { return 0; }
   int read() { return -1; }
   int parseInt() { return -1; }
@@ -67,17 +102,43 @@ struct SerialType {
 #define NEO_GRB 0
 #define NEO_KHZ800 0
 
+// WS2812 전송 시간 모델 (800kHz, LED당 24bit x 1.25us)
+// 실제 show()는 전송 동안 인터럽트를 끄므로 시리얼 수신, millis(), 자석 스캔이 멈춤
+#define WS2812_US_PER_LED 30
+#define WS2812_LATCH_US 300        // 래치(reset) 최소 간격 (WS2812B)
+#define WS2812_MILLIS_TICK_US 1024 // AVR timer0 오버플로 주기 (1개만 보류됨)
+#define WS2812_UART_BYTE_US 87     // 115200bps에서 1바이트 수신 시간
+#define WS2812_UART_FIFO 2         // AVR UART 수신 버퍼 (바이트)
+#ifndef WS2812_SIMULATE_TIMING
+#define WS2812_SIMULATE_TIMING 0 // 1이면 show()가 전송 시간만큼 실제로 대기 (-D로 켬)
+#endif
+
 class Adafruit_NeoPixel {
 public:
   Adafruit_NeoPixel(int n, int /*pin*/, int /*flags*/)
-      : _n(n), _brightness(20) {
+      : _n(n), _brightness(20), _shows(0), _busyUs(0), _maxIrqOffUs(0),
+        _lostMillisUs(0), _rxOverrunBytes(0) {
     _pixels = new uint32_t[_n];
     clear();
   }
   ~Adafruit_NeoPixel() { delete[] _pixels; }
 
   void begin() {}
-  void show() {}
+  void show() {
+    unsigned long transferUs = (unsigned long)_n * WS2812_US_PER_LED;
+    _shows++;
+    _busyUs += transferUs;
+    if (transferUs > _maxIrqOffUs)
+      _maxIrqOffUs = transferUs;
+    if (transferUs > WS2812_MILLIS_TICK_US)
+      _lostMillisUs += transferUs - WS2812_MILLIS_TICK_US;
+    unsigned long rxBytes = transferUs / WS2812_UART_BYTE_US;
+    if (rxBytes > WS2812_UART_FIFO)
+      _rxOverrunBytes += rxBytes - WS2812_UART_FIFO;
+#if WS2812_SIMULATE_TIMING
+    delayMicroseconds(transferUs);
+#endif
+  }
   void setBrightness(uint8_t b) { _brightness = b; }
   uint8_t getBrightness() const { return _brightness; }
   void clear() {
@@ -97,16 +158,33 @@ public:
     return 0;
   }
 
+  // 전송 시간 모델 요약: 누적 점유 시간, 최대 인터럽트 차단 구간, 최대 프레임 속도
+  void printTransferStats() const {
+    unsigned long transferUs = (unsigned long)_n * WS2812_US_PER_LED;
+    std::printf("WS2812: leds=%d shows=%lu busy_ms=%lu irq_off_max_us=%lu "
+                "millis_lost_ms=%lu max_fps=%lu rx_overrun_bytes=%lu\n",
+                _n, _shows, _busyUs / 1000, _maxIrqOffUs, _lostMillisUs / 1000,
+                1000000UL / (transferUs + WS2812_LATCH_US), _rxOverrunBytes);
+    std::fflush(stdout);
+  }
+
 private:
   int _n;
   uint8_t _brightness;
   uint32_t *_pixels;
+  unsigned long _shows;
+  unsigned long _busyUs;       // show()에 쓰인 누적 시간
+  unsigned long _maxIrqOffUs;  // 가장 긴 인터럽트 차단 구간
+  unsigned long _lostMillisUs; // 차단 중 놓친 timer0 tick
+  unsigned long _rxOverrunBytes; // 수신이 계속됐다면 차단 중 넘쳤을 UART 바이트
 };
 
 #else
 // ================= 실제 Arduino 빌드용 =================
 #include <Adafruit_NeoPixel.h>
 #include <Arduino.h>
+#include "disjoint_set.h"
+#include "edge_table.h"
 #ifdef __AVR__
 #include <avr/power.h>
 #endif
@@ -145,6 +223,152 @@ static int currentFrameNumber = 0;
 static uint8_t lastBrightness = 255;
 static float animationSpeed = 1.0;
 
+// 구간별 타이밍 (알고리즘 / 그리기 / 시리얼 출력)
+// -DPROFILE_PHASES=1로 빌드하면 활성화, 아니면 매크로가 모두 빈 코드가 됨
+// 중첩된 구간은 자기 시간만 기록 (예: 그리기 안의 serialPrintFrame은 io로 분리)
+#ifndef PROFILE_PHASES
+#define PROFILE_PHASES 0
+#endif
+
+#if PROFILE_PHASES
+enum Phase { PHASE_ALGO, PHASE_RENDER, PHASE_IO, PHASE_COUNT };
+
+#ifdef TARGET_PC
+#define PHASE_UNIT "ns"
+#define PHASE_SUB_BITS 2 // 2의 거듭제곱 구간을 4칸으로 나눔 (오차 25% 이내)
+static inline uint32_t phaseClock() {
+  return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+#else
+#define PHASE_UNIT "us"
+#define PHASE_SUB_BITS 0 // SRAM 절약: 2의 거듭제곱 단위
+static inline uint32_t phaseClock() { return micros(); }
+#endif
+
+#define PHASE_BUCKETS ((33 - PHASE_SUB_BITS) << PHASE_SUB_BITS)
+
+struct PhaseHistogram {
+  uint32_t count;
+  uint32_t minValue;
+  uint32_t maxValue;
+  uint32_t buckets[PHASE_BUCKETS];
+};
+
+static PhaseHistogram phaseHist[PHASE_COUNT];
+
+// 로그 스케일 버킷 번호
+static uint8_t phaseBucket(uint32_t v) {
+  if (v < (1UL << PHASE_SUB_BITS))
+    return (uint8_t)v;
+  uint8_t msb = 31;
+  while (!(v & (1UL << msb)))
+    msb--;
+  uint8_t sub = (v >> (msb - PHASE_SUB_BITS)) & ((1 << PHASE_SUB_BITS) - 1);
+  return ((msb - PHASE_SUB_BITS + 1) << PHASE_SUB_BITS) + sub;
+}
+
+// 버킷이 담당하는 최대값
+static uint32_t phaseBucketUpper(uint8_t bucket) {
+  if (bucket < (1 << PHASE_SUB_BITS))
+    return bucket;
+  uint8_t msb = (bucket >> PHASE_SUB_BITS) + PHASE_SUB_BITS - 1;
+  uint32_t sub = bucket & ((1 << PHASE_SUB_BITS) - 1);
+  uint32_t lower = (1UL << msb) | (sub << (msb - PHASE_SUB_BITS));
+  return lower + (1UL << (msb - PHASE_SUB_BITS)) - 1;
+}
+
+void phaseRecord(uint8_t phase, uint32_t elapsed) {
+  PhaseHistogram &h = phaseHist[phase];
+  if (h.count == 0 || elapsed < h.minValue)
+    h.minValue = elapsed;
+  if (elapsed > h.maxValue)
+    h.maxValue = elapsed;
+  h.count++;
+  h.buckets[phaseBucket(elapsed)]++;
+}
+
+uint32_t phaseQuantile(uint8_t phase, uint32_t permille) {
+  PhaseHistogram &h = phaseHist[phase];
+  uint32_t rank = (h.count * permille + 999) / 1000;
+  uint32_t seen = 0;
+  for (int i = 0; i < PHASE_BUCKETS; i++) {
+    seen += h.buckets[i];
+    if (seen >= rank && seen > 0) {
+      uint32_t upper = phaseBucketUpper(i);
+      return upper < h.maxValue ? upper : h.maxValue;
+    }
+  }
+  return h.maxValue;
+}
+
+// 스코프 타이머: 생성~소멸 구간을 기록, 안쪽 구간이 열리면 바깥 구간은 잠시 멈춤
+struct PhaseScope {
+  static PhaseScope *active;
+  PhaseScope *parent;
+  uint32_t start;
+  uint32_t elapsed;
+  uint8_t phase;
+  bool merged; // 같은 구간 안에서 다시 열린 경우 바깥 구간에 합침
+
+  explicit PhaseScope(uint8_t p) : parent(active), elapsed(0), phase(p) {
+    merged = parent && parent->phase == p;
+    if (merged)
+      return;
+    start = phaseClock();
+    if (parent)
+      parent->elapsed += start - parent->start;
+    active = this;
+  }
+
+  ~PhaseScope() {
+    if (merged)
+      return;
+    uint32_t now = phaseClock();
+    phaseRecord(phase, elapsed + (now - start));
+    active = parent;
+    if (parent)
+      parent->start = now;
+  }
+};
+
+PhaseScope *PhaseScope::active = 0;
+
+void serialPrintPhaseStats() {
+  static const char *names[PHASE_COUNT] = {"algo", "render", "io"};
+  for (uint8_t p = 0; p < PHASE_COUNT; p++) {
+    Serial.print(F("PHASE:"));
+    Serial.print(names[p]);
+    Serial.print(F(" n="));
+    Serial.print((unsigned long)phaseHist[p].count);
+    Serial.print(F(" min="));
+    Serial.print((unsigned long)phaseHist[p].minValue);
+    Serial.print(F(" p50="));
+    Serial.print((unsigned long)phaseQuantile(p, 500));
+    Serial.print(F(" p99="));
+    Serial.print((unsigned long)phaseQuantile(p, 990));
+    Serial.print(F(" max="));
+    Serial.print((unsigned long)phaseHist[p].maxValue);
+    Serial.println(F(" " PHASE_UNIT));
+  }
+}
+
+// 실행 시작마다 호출: 보고가 그 실행의 구간만 담도록 히스토그램을 비움
+void phaseReset() {
+  for (uint8_t p = 0; p < PHASE_COUNT; p++)
+    phaseHist[p] = PhaseHistogram();
+}
+
+#define PHASE_SCOPE(p) PhaseScope phaseScope(p)
+#define PHASE_REPORT() serialPrintPhaseStats()
+#define PHASE_RESET() phaseReset()
+#else
+#define PHASE_SCOPE(p)
+#define PHASE_REPORT()
+#define PHASE_RESET()
+#endif
+
 void printHex(uint8_t value) {
   if (value < 16)
     Serial.print("0");
@@ -152,6 +376,7 @@ void printHex(uint8_t value) {
 }
 
 void serialPrintFrame() {
+  PHASE_SCOPE(PHASE_IO);
   Serial.print(F("FRAME:"));
   Serial.println(currentFrameNumber);
 
@@ -188,6 +413,7 @@ void setPixel(int x, int y, uint8_t r, uint8_t g, uint8_t b) {
 void clearDisplay() { strip.clear(); }
 
 void showDisplay() {
+  PHASE_SCOPE(PHASE_IO);
   uint8_t currentBrightness = strip.getBrightness();
   if (currentBrightness != lastBrightness) {
     Serial.print(F("BRIGHTNESS:"));
@@ -201,10 +427,86 @@ void showDisplay() {
 
 void setBrightness(uint8_t level) { strip.setBrightness(level); }
 
+// 프레임 페이싱 (절대 마감 기준)
+// 각 스텝의 목표 표시 시각 = 이전 목표 시각 + 지연 시간
+// 그리기/시리얼 출력 시간이 지연에 더해지지 않으므로 오래 실행해도 오차가 누적되지 않음
+#define PACE_MAX_CATCHUP_US 250000UL // 이보다 늦으면 일정을 현재 시각으로 재설정
+
+static unsigned long frameDeadline = 0; // 다음 프레임 목표 시각 (micros)
+static bool frameDeadlineSet = false;
+static unsigned long pacedFrames = 0;
+static unsigned long lateFrames = 0;
+static unsigned long maxLateUs = 0;
+static unsigned long totalLateUs = 0;
+
+void sleepUntilMicros(unsigned long target) {
+#ifdef TARGET_PC
+  struct timespec ts = monotonicOrigin();
+  ts.tv_sec += target / 1000000UL;
+  ts.tv_nsec += (long)(target % 1000000UL) * 1000L;
+  if (ts.tv_nsec >= 1000000000L) {
+    ts.tv_sec++;
+    ts.tv_nsec -= 1000000000L;
+  }
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+  }
+#else
+  // 대부분은 delay()로 자고 마지막 1ms 정도만 micros()로 맞춤
+  long remaining = (long)(target - micros());
+  if (remaining > 2000)
+    delay((remaining - 1000) / 1000);
+  while ((long)(target - micros()) > 0) {
+  }
+#endif
+}
+
 void hardwareDelay(unsigned long ms) {
   if (animationSpeed <= 0.0)
     animationSpeed = 1.0;
-  delay((unsigned long)(ms / animationSpeed));
+
+  unsigned long now = micros();
+  if (!frameDeadlineSet) {
+    frameDeadline = now;
+    frameDeadlineSet = true;
+  }
+  frameDeadline += (unsigned long)(ms * 1000.0 / animationSpeed);
+  pacedFrames++;
+
+  long slack = (long)(frameDeadline - now);
+  if (slack >= 0) {
+    sleepUntilMicros(frameDeadline);
+    return;
+  }
+
+  // 이미 목표 시각을 지남: 지각 프레임으로 기록
+  unsigned long late = (unsigned long)(-slack);
+  lateFrames++;
+  totalLateUs += late;
+  if (late > maxLateUs)
+    maxLateUs = late;
+  if (late > PACE_MAX_CATCHUP_US)
+    frameDeadline = now;
+}
+
+// 실행마다 새로 시작: 통계를 비우고, 이전 실행이나 그 뒤의 대기 시간이
+// 첫 프레임의 지각으로 잡히지 않도록 일정도 다음 hardwareDelay()에서 다시 잡음
+void pacingReset() {
+  frameDeadlineSet = false;
+  pacedFrames = 0;
+  lateFrames = 0;
+  maxLateUs = 0;
+  totalLateUs = 0;
+}
+
+void serialPrintPacingStats() {
+  Serial.print(F("PACING: frames="));
+  Serial.print(pacedFrames);
+  Serial.print(F(" late="));
+  Serial.print(lateFrames);
+  Serial.print(F(" max_late_us="));
+  Serial.print(maxLateUs);
+  Serial.print(F(" avg_late_us="));
+  Serial.println(lateFrames > 0 ? totalLateUs / lateFrames : 0UL);
 }
 
 void setAnimationSpeed(float speed) { animationSpeed = speed; }
@@ -213,17 +515,25 @@ void setAnimationSpeed(float speed) { animationSpeed = speed; }
 // 4. 그래프 알고리즘 - 데이터 구조
 // ============================================================================
 
+#ifdef TARGET_PC
+#define MAX_NODES LED_COUNT // --show로 읽은 그래프 (노드마다 픽셀 하나)
+#define MAX_EDGES 1024
+#else
 #define MAX_NODES 10
 #define MAX_EDGES 25
+#endif
 
 struct NodePos {
   int x, y;
 };
 
-struct Edge {
-  int u, v;
-  int weight;
-};
+// 간선 표: 열(SoA) 3개, 정수 폭은 컴파일 시 선택 (edge_table.h)
+// 보드는 노드 10개 / 가중치 9 이하라 모두 uint8_t (간선당 3바이트)
+#ifdef TARGET_PC
+typedef EdgeTable<uint8_t, int32_t, MAX_EDGES> SketchEdges; // --show 파일 가중치
+#else
+typedef EdgeTable<uint8_t, uint8_t, MAX_EDGES> SketchEdges;
+#endif
 
 // 10개 노드를 비대칭적으로 배치 (무작위 느낌)
 NodePos nodes[MAX_NODES] = {
@@ -239,31 +549,33 @@ NodePos nodes[MAX_NODES] = {
     {7, 4}    // 9
 };
 
-// 20개 간선 (실제 유클리드 거리 기반 가중치)
+// 20개 간선 (실제 유클리드 거리 기반 가중치), {u, v, 가중치} 행으로 플래시에 두고 edges로 옮김
 // 가중치 = sqrt((x2-x1)^2 + (y2-y1)^2) 반올림
-Edge edges[MAX_EDGES] = {
+const uint8_t demoEdges[][3] PROGMEM = {
     {0, 1, 8}, // (3,2)-(11,3): sqrt(64+1)=8.06
     {0, 5, 9}, // (3,2)-(2,11): sqrt(1+81)=9.06
-    {0, 9, 5}, // (3,2)-(7,4): sqrt(16+4)=4.47
+    {0, 9, 4}, // (3,2)-(7,4): sqrt(16+4)=4.47
     {1, 2, 5}, // (11,3)-(14,7): sqrt(9+16)=5
     {1, 9, 4}, // (11,3)-(7,4): sqrt(16+1)=4.12
     {1, 7, 6}, // (11,3)-(9,9): sqrt(4+36)=6.32
     {2, 3, 6}, // (14,7)-(13,13): sqrt(1+36)=6.08
-    {2, 8, 5}, // (14,7)-(12,11): sqrt(4+16)=4.47
+    {2, 8, 4}, // (14,7)-(12,11): sqrt(4+16)=4.47
     {3, 4, 6}, // (13,13)-(7,14): sqrt(36+1)=6.08
     {3, 8, 2}, // (13,13)-(12,11): sqrt(1+4)=2.24
     {4, 5, 6}, // (7,14)-(2,11): sqrt(25+9)=5.83
     {4, 6, 7}, // (7,14)-(5,7): sqrt(4+49)=7.28
-    {4, 7, 6}, // (7,14)-(9,9): sqrt(4+25)=5.39
+    {4, 7, 5}, // (7,14)-(9,9): sqrt(4+25)=5.39
     {5, 6, 5}, // (2,11)-(5,7): sqrt(9+16)=5
-    {6, 7, 5}, // (5,7)-(9,9): sqrt(16+4)=4.47
+    {6, 7, 4}, // (5,7)-(9,9): sqrt(16+4)=4.47
     {6, 9, 4}, // (5,7)-(7,4): sqrt(4+9)=3.61
     {7, 8, 4}, // (9,9)-(12,11): sqrt(9+4)=3.61
-    {7, 9, 6}, // (9,9)-(7,4): sqrt(4+25)=5.39
+    {7, 9, 5}, // (9,9)-(7,4): sqrt(4+25)=5.39
     {8, 3, 2}, // 중복 제거 (이미 3-8로 표현)
     {9, 1, 4}  // 중복 제거 (이미 1-9로 표현)
 };
 
+SketchEdges edges(demoEdges, 20);
+
 int nodeCount = 10;
 int edgeCount = 20;
 
@@ -378,9 +690,10 @@ void drawEdge(int u, int v, int color) {
 
 // 그래프 전체 그리기 (모든 간선 + 모든 노드)
 void drawGraph() {
+  PHASE_SCOPE(PHASE_RENDER);
   // 간선 먼저
   for (int i = 0; i < edgeCount; i++) {
-    drawEdge(edges[i].u, edges[i].v, 0);
+    drawEdge(edges.u[i], edges.v[i], 0);
   }
   // 노드 나중에 (위에 표시)
   for (int i = 0; i < nodeCount; i++) {
@@ -397,62 +710,75 @@ void clearAndDrawGraph() {
 // 6. Kruskal MST 알고리즘 (Union-Find)
 // ============================================================================
 
-int parent[MAX_NODES];
-int rank_[MAX_NODES];
+// 노드 번호는 MAX_NODES(보드에서는 255 이하)라 uint8_t로 충분 (반복 find, 재귀 없음)
+// 경로 압축이 없는 되돌리기 버전: 되감기("<", "@ N")가 합치기를 O(1)로 취소
+#if MAX_NODES > 255
+RollbackDisjointSet<uint16_t> sets;
+#else
+RollbackDisjointSet<uint8_t> sets;
+#endif
 
-void makeSet(int v) {
-  parent[v] = v;
-  rank_[v] = 0;
+bool unionSets(int u, int v) {
+  PHASE_SCOPE(PHASE_ALGO);
+  return sets.unite(u, v); // false면 사이클 발생
 }
 
-int findSet(int v) {
-  if (v == parent[v])
-    return v;
-  return parent[v] = findSet(parent[v]); // path compression
+// 간선 정렬 (안정 정렬: 같은 가중치는 원래 순서 유지)
+// 간선 번호만 삽입 정렬한 뒤 열마다 한 번씩 재배치 (EdgeTable::sortByWeight)
+// 큰 그래프는 graph_edges.h의 radixSortPermutation()이 같은 순서 규칙으로 정렬함
+void sortEdges() {
+  PHASE_SCOPE(PHASE_ALGO);
+  edges.sortByWeight(edgeCount);
 }
 
-bool unionSets(int u, int v) {
-  int rootU = findSet(u);
-  int rootV = findSet(v);
+// MST에 포함된 간선 추적
+bool inMST[MAX_EDGES];
 
-  if (rootU == rootV)
-    return false; // 사이클 발생
+// 되감기 상태: 정렬된 edges[] 중 앞에서 kruskalStep개를 처리한 시점
+// 간선이 바뀌거나(7절) 클러스터링(8절)이 sets를 다시 쓰면 timelineValid = false
+int kruskalStep = 0;
+bool timelineValid = false;
 
-  // union by rank
-  if (rank_[rootU] < rank_[rootV]) {
-    parent[rootU] = rootV;
-  } else if (rank_[rootU] > rank_[rootV]) {
-    parent[rootV] = rootU;
-  } else {
-    parent[rootV] = rootU;
-    rank_[rootU]++;
+// 진행 상태 그리기: 앞서 선택된 MST 간선(초록) 위에 i번 간선을 edgeColor로 강조
+// highlightNodes가 true면 i번 간선의 양 끝 노드를 빨간색으로 표시
+void drawKruskalStep(int i, int edgeColor, bool highlightNodes) {
+  PHASE_SCOPE(PHASE_RENDER);
+  clearDisplay();
+
+  // 모든 간선을 회색으로
+  for (int j = 0; j < edgeCount; j++) {
+    drawEdge(edges.u[j], edges.v[j], 0);
   }
-  return true;
-}
 
-// 간선 정렬 (버블 소트)
-void sortEdges() {
-  for (int i = 0; i < edgeCount - 1; i++) {
-    for (int j = 0; j < edgeCount - i - 1; j++) {
-      if (edges[j].weight > edges[j + 1].weight) {
-        Edge temp = edges[j];
-        edges[j] = edges[j + 1];
-        edges[j + 1] = temp;
-      }
+  // MST 간선들을 초록색으로 (누적)
+  for (int j = 0; j < i; j++) {
+    if (inMST[j]) {
+      drawEdge(edges.u[j], edges.v[j], 2);
     }
   }
-}
 
-// MST에 포함된 간선 추적
-bool inMST[MAX_EDGES];
+  // 현재 간선 강조
+  drawEdge(edges.u[i], edges.v[i], edgeColor);
+
+  // 모든 노드를 회색으로, 필요하면 현재 선택된 두 노드만 빨간색으로
+  for (int k = 0; k < nodeCount; k++) {
+    drawNode(k, 0);
+  }
+  if (highlightNodes) {
+    drawNode(edges.u[i], 2);
+    drawNode(edges.v[i], 2);
+  }
+
+  showDisplay();
+}
 
 void kruskalMST() {
+  pacingReset();
+  PHASE_RESET();
   Serial.println(F("\n=== Kruskal MST Algorithm ==="));
 
   // 1. 초기화
-  for (int i = 0; i < nodeCount; i++) {
-    makeSet(i);
-  }
+  sets.resize(nodeCount);
   for (int i = 0; i < MAX_EDGES; i++) {
     inMST[i] = false;
   }
@@ -463,11 +789,11 @@ void kruskalMST() {
   Serial.println(F("Edges sorted by weight:"));
   for (int i = 0; i < edgeCount; i++) {
     Serial.print(F("  Edge "));
-    Serial.print(edges[i].u);
+    Serial.print(edges.u[i]);
     Serial.print(F("-"));
-    Serial.print(edges[i].v);
+    Serial.print(edges.v[i]);
     Serial.print(F(" weight: "));
-    Serial.println(edges[i].weight);
+    Serial.println(edges.w[i]);
   }
 
   // 초기 그래프 표시
@@ -479,10 +805,11 @@ void kruskalMST() {
   int mstEdgeCount = 0;
   int mstWeight = 0;
 
-  for (int i = 0; i < edgeCount && mstEdgeCount < nodeCount - 1; i++) {
-    int u = edges[i].u;
-    int v = edges[i].v;
-    int w = edges[i].weight;
+  int i = 0;
+  for (; i < edgeCount && mstEdgeCount < nodeCount - 1; i++) {
+    int u = edges.u[i];
+    int v = edges.v[i];
+    int w = edges.w[i];
 
     Serial.print(F("\nConsidering edge "));
     Serial.print(u);
@@ -493,31 +820,7 @@ void kruskalMST() {
     Serial.println(F(")"));
 
     // 기존 MST를 유지하면서 현재 간선만 노란색으로 강조
-    clearDisplay();
-
-    // 1. 모든 간선을 어두운 회색으로
-    for (int j = 0; j < edgeCount; j++) {
-      drawEdge(edges[j].u, edges[j].v, 0);
-    }
-
-    // 2. MST 간선들을 초록색으로 (누적)
-    for (int j = 0; j < i; j++) {
-      if (inMST[j]) {
-        drawEdge(edges[j].u, edges[j].v, 2);
-      }
-    }
-
-    // 3. 현재 고려 중인 간선을 노란색으로
-    drawEdge(u, v, 1);
-
-    // 4. 모든 노드를 회색으로, 현재 선택된 두 노드만 빨간색으로
-    for (int k = 0; k < nodeCount; k++) {
-      drawNode(k, 0);
-    }
-    drawNode(u, 2);
-    drawNode(v, 2);
-
-    showDisplay();
+    drawKruskalStep(i, 1, true);
     hardwareDelay(800);
 
     // Union-Find로 사이클 검사
@@ -528,65 +831,32 @@ void kruskalMST() {
       mstWeight += w;
 
       // MST 간선으로 확정 - 초록색으로 변경
-      clearDisplay();
-
-      // 모든 간선을 회색으로
-      for (int j = 0; j < edgeCount; j++) {
-        drawEdge(edges[j].u, edges[j].v, 0);
-      }
-
-      // MST 간선들을 초록색으로
-      for (int j = 0; j <= i; j++) {
-        if (inMST[j]) {
-          drawEdge(edges[j].u, edges[j].v, 2);
-        }
-      }
-
-      // 모든 노드를 회색으로
-      for (int k = 0; k < nodeCount; k++) {
-        drawNode(k, 0);
-      }
-
-      showDisplay();
+      drawKruskalStep(i, 2, false);
       hardwareDelay(500);
 
     } else {
       Serial.println(F("  -> Rejected (forms cycle)"));
 
       // 거부된 간선 잠깐 빨간색으로 표시
-      clearDisplay();
-
-      // 모든 간선을 회색으로
-      for (int j = 0; j < edgeCount; j++) {
-        drawEdge(edges[j].u, edges[j].v, 0);
-      }
-
-      // MST 간선들을 초록색으로
-      for (int j = 0; j < i; j++) {
-        if (inMST[j]) {
-          drawEdge(edges[j].u, edges[j].v, 2);
-        }
-      }
-
-      // 거부된 간선을 빨간색으로
-      drawEdge(u, v, 3);
-
-      // 모든 노드를 회색으로
-      for (int k = 0; k < nodeCount; k++) {
-        drawNode(k, 0);
-      }
-
-      showDisplay();
+      drawKruskalStep(i, 3, false);
       hardwareDelay(500);
     }
   }
 
+  kruskalStep = i;
+  timelineValid = true;
+
   // 최종 결과
   Serial.println(F("\n=== MST Complete ==="));
   Serial.print(F("Total edges in MST: "));
   Serial.println(mstEdgeCount);
   Serial.print(F("Total weight: "));
   Serial.println(mstWeight);
+  serialPrintPacingStats();
+  PHASE_REPORT();
+#ifdef TARGET_PC
+  strip.printTransferStats();
+#endif
 
   // 최종 MST 표시 (MST 간선만 밝게)
   clearDisplay();
@@ -594,7 +864,7 @@ void kruskalMST() {
   // MST 간선들만 밝은 초록색으로
   for (int i = 0; i < edgeCount; i++) {
     if (inMST[i]) {
-      drawEdge(edges[i].u, edges[i].v, 2);
+      drawEdge(edges.u[i], edges.v[i], 2);
     }
   }
 
@@ -607,8 +877,433 @@ void kruskalMST() {
   hardwareDelay(3000);
 }
 
+// 되감기 (time travel): 한 단계 앞으로 = 간선 하나 합치기 시도,
+// 한 단계 뒤로 = 그 간선이 MST에 들어갔으면 마지막 합치기 취소 (O(1))
+// 그래서 "@ N"은 처음부터 다시 돌리지 않고 |N - 현재|단계만 움직임
+// 명령: "<" 한 단계 뒤로, ">" 한 단계 앞으로, "@ N" N단계 시점으로 (7절 명령과 같은 입력)
+
+bool kruskalAdvance() {
+  if (kruskalStep >= edgeCount)
+    return false;
+  int i = kruskalStep++;
+  inMST[i] = unionSets(edges.u[i], edges.v[i]);
+  return true;
+}
+
+bool kruskalRetreat() {
+  if (kruskalStep <= 0)
+    return false;
+  int i = --kruskalStep;
+  if (inMST[i]) {
+    PHASE_SCOPE(PHASE_ALGO);
+    sets.undo();
+    inMST[i] = false;
+  }
+  return true;
+}
+
+// 7절/8절이 edges[]나 sets를 바꾸기 전에 호출: 남은 단계를 끝까지 진행해
+// inMST[]를 완성된 MST로 만들고 되감기 기록은 버림 (다음 되감기는 다시 정렬부터)
+void finishTimeline() {
+  if (!timelineValid)
+    return;
+  while (kruskalAdvance()) {
+  }
+  timelineValid = false;
+}
+
+void serialPrintMstWeight(); // 7절
+
+// 간선이 바뀐 뒤라면 현재 그래프로 처음부터 다시 정렬
+void rebuildTimeline() {
+  sortEdges();
+  sets.resize(nodeCount);
+  for (int i = 0; i < MAX_EDGES; i++) {
+    inMST[i] = false;
+  }
+  kruskalStep = 0;
+  timelineValid = true;
+}
+
+// step번째 간선까지 처리한 상태로 이동해 그 시점의 그림을 보여줌
+void kruskalSeek(int step) {
+  if (step < 0)
+    step = 0;
+  if (step > edgeCount)
+    step = edgeCount;
+  if (!timelineValid)
+    rebuildTimeline();
+  while (kruskalStep < step)
+    kruskalAdvance();
+  while (kruskalStep > step)
+    kruskalRetreat();
+
+  Serial.print(F("\nStep "));
+  Serial.print(kruskalStep);
+  Serial.print(F("/"));
+  Serial.print(edgeCount);
+  if (kruskalStep == 0) {
+    Serial.println();
+    clearAndDrawGraph();
+    showDisplay();
+  } else {
+    int i = kruskalStep - 1;
+    Serial.print(F(": edge "));
+    Serial.print(edges.u[i]);
+    Serial.print(F("-"));
+    Serial.print(edges.v[i]);
+    Serial.print(F(" (weight "));
+    Serial.print(edges.w[i]);
+    Serial.println(inMST[i] ? F(") added") : F(") rejected"));
+    drawKruskalStep(i, inMST[i] ? 2 : 3, false);
+  }
+  Serial.print(F("  Components: "));
+  Serial.println((int)sets.sets());
+  serialPrintMstWeight();
+}
+
 // ============================================================================
-// 7. Setup & Loop
+// 7. 동적 MST (실시간 간선 추가/삭제)
+// ============================================================================
+// kruskalMST() 이후 간선이 바뀌면 정렬과 애니메이션을 처음부터 다시 하지 않고
+// 현재 트리만 고침 (큰 그래프는 dynamic_mst.h의 DynamicMst가 같은 규칙)
+// - 추가: 두 끝점 사이 트리 경로의 최대 간선보다 가벼우면 그 간선과 교체
+// - 삭제: 트리 간선이면 잘린 두 쪽을 잇는 가장 가벼운 비트리 간선으로 대체
+// 바뀐 간선만 강조 (노란색: 트리에 들어옴, 빨강: 트리에서 빠짐/거부)
+// 명령: "+ u v w" 추가, "- u v [w]" 삭제 (시리얼 한 줄, PC는 --live로 stdin)
+// 같은 두 정점 사이에 평행 간선을 더할 수 있음 (경로 최대 간선과 비교하는 규칙이
+// 그대로 성립). 삭제할 때 w를 주면 그 가중치의 간선, 없으면 처음 찾은 간선
+
+bool treeReached[MAX_NODES]; // markTree()에서 도달한 노드
+int treeInEdge[MAX_NODES];   // 그 노드로 들어온 MST 간선 (-1: 시작점)
+
+// from에서 MST 간선만 따라 탐색 (반복 DFS)
+void markTree(int from) {
+  int stack[MAX_NODES];
+  int top = 0;
+  for (int k = 0; k < nodeCount; k++) {
+    treeReached[k] = false;
+    treeInEdge[k] = -1;
+  }
+  treeReached[from] = true;
+  stack[top++] = from;
+  while (top > 0) {
+    int x = stack[--top];
+    for (int i = 0; i < edgeCount; i++) {
+      if (!inMST[i])
+        continue;
+      int y = edges.u[i] == x ? edges.v[i] : (edges.v[i] == x ? edges.u[i] : -1);
+      if (y < 0 || treeReached[y])
+        continue;
+      treeReached[y] = true;
+      treeInEdge[y] = i;
+      stack[top++] = y;
+    }
+  }
+}
+
+// u-v 트리 경로에서 가장 무거운 간선 (-1: 연결되어 있지 않음)
+int treePathMax(int u, int v) {
+  markTree(u);
+  if (!treeReached[v])
+    return -1;
+  int heaviest = -1;
+  for (int x = v; x != u;) {
+    int e = treeInEdge[x];
+    if (heaviest < 0 || edges.w[e] > edges.w[heaviest])
+      heaviest = e;
+    x = edges.u[e] == x ? edges.v[e] : edges.u[e];
+  }
+  return heaviest;
+}
+
+// 평행 간선이 있으면 byWeight일 때 가중치 w인 것, 아니면 처음 찾은 것
+int findEdge(int u, int v, bool byWeight = false, int w = 0) {
+  for (int i = 0; i < edgeCount; i++) {
+    if (((edges.u[i] == u && edges.v[i] == v) ||
+         (edges.u[i] == v && edges.v[i] == u)) &&
+        (!byWeight || edges.w[i] == w))
+      return i;
+  }
+  return -1;
+}
+
+// 현재 그래프 위에 바뀐 간선만 강조 (-1이면 없음)
+void drawMstChange(int enteredEdge, int leftEdge) {
+  PHASE_SCOPE(PHASE_RENDER);
+  clearDisplay();
+  for (int i = 0; i < edgeCount; i++) {
+    if (i != enteredEdge && i != leftEdge)
+      drawEdge(edges.u[i], edges.v[i], inMST[i] ? 2 : 0);
+  }
+  if (leftEdge >= 0)
+    drawEdge(edges.u[leftEdge], edges.v[leftEdge], 3);
+  if (enteredEdge >= 0)
+    drawEdge(edges.u[enteredEdge], edges.v[enteredEdge], 1);
+  for (int k = 0; k < nodeCount; k++) {
+    drawNode(k, 0);
+  }
+  showDisplay();
+}
+
+void serialPrintMstWeight() {
+  int total = 0;
+  for (int i = 0; i < edgeCount; i++) {
+    if (inMST[i])
+      total += edges.w[i];
+  }
+  Serial.print(F("  MST weight: "));
+  Serial.println(total);
+}
+
+void insertEdgeLive(int u, int v, int w) {
+  finishTimeline();
+  if (u < 0 || u >= nodeCount || v < 0 || v >= nodeCount || u == v ||
+      !SketchEdges::weightFits(w) || edgeCount >= MAX_EDGES) {
+    Serial.println(F("  -> Invalid edge"));
+    return;
+  }
+  int e = edgeCount++;
+  edges.set(e, u, v, w);
+  inMST[e] = false;
+
+  int replaced = -1;
+  {
+    PHASE_SCOPE(PHASE_ALGO);
+    int heaviest = treePathMax(u, v);
+    if (heaviest < 0) {
+      inMST[e] = true; // 서로 다른 트리를 이음
+    } else if (edges.w[heaviest] > w) {
+      inMST[heaviest] = false;
+      inMST[e] = true;
+      replaced = heaviest;
+    }
+  }
+
+  if (inMST[e]) {
+    Serial.println(F("  -> Added to MST"));
+    if (replaced >= 0) {
+      Serial.print(F("  -> Replaces "));
+      Serial.print(edges.u[replaced]);
+      Serial.print(F("-"));
+      Serial.println(edges.v[replaced]);
+    }
+    drawMstChange(e, replaced);
+  } else {
+    Serial.println(F("  -> Not in MST (heaviest on its cycle)"));
+    drawMstChange(-1, e);
+  }
+  serialPrintMstWeight();
+  hardwareDelay(800);
+  drawMstChange(-1, -1);
+}
+
+void deleteEdgeLive(int u, int v, bool byWeight, int w) {
+  finishTimeline();
+  int e = findEdge(u, v, byWeight, w);
+  if (e < 0) {
+    Serial.println(F("  -> No such edge"));
+    return;
+  }
+
+  int replacement = -1;
+  if (inMST[e]) {
+    PHASE_SCOPE(PHASE_ALGO);
+    inMST[e] = false;
+    markTree(edges.u[e]); // 잘린 뒤 u쪽
+    for (int i = 0; i < edgeCount; i++) {
+      if (i == e || inMST[i] ||
+          treeReached[edges.u[i]] == treeReached[edges.v[i]])
+        continue;
+      if (replacement < 0 || edges.w[i] < edges.w[replacement])
+        replacement = i;
+    }
+    if (replacement >= 0)
+      inMST[replacement] = true;
+  }
+
+  if (replacement >= 0) {
+    Serial.print(F("  -> Replaced by "));
+    Serial.print(edges.u[replacement]);
+    Serial.print(F("-"));
+    Serial.println(edges.v[replacement]);
+  }
+  drawMstChange(replacement, e);
+  hardwareDelay(800);
+
+  // 마지막 간선을 빈 자리로 옮겨 배열을 채움
+  edgeCount--;
+  edges.copy(e, edgeCount);
+  inMST[e] = inMST[edgeCount];
+  inMST[edgeCount] = false;
+  serialPrintMstWeight();
+  drawMstChange(-1, -1);
+}
+
+void showClusters(int k); // 8절
+
+// "+ u v w" / "- u v [w]" / "k N" (8절 클러스터링) / "<" ">" "@ N" (6절 되감기)
+void handleEdgeCommand(const char *line) {
+  char op = 0;
+  int u = -1, v = -1, w = 0;
+  int fields = sscanf(line, " %c %d %d %d", &op, &u, &v, &w);
+  pacingReset(); // 명령 하나가 한 번의 실행 (명령 사이 대기는 지각이 아님)
+  if (op == '+' && fields == 4) {
+    Serial.print(F("\nInsert edge "));
+    Serial.print(u);
+    Serial.print(F("-"));
+    Serial.print(v);
+    Serial.print(F(" (weight "));
+    Serial.print(w);
+    Serial.println(F(")"));
+    insertEdgeLive(u, v, w);
+  } else if (op == '-' && fields >= 3) {
+    Serial.print(F("\nDelete edge "));
+    Serial.print(u);
+    Serial.print(F("-"));
+    Serial.println(v);
+    deleteEdgeLive(u, v, fields == 4, w);
+  } else if (op == 'k' && fields >= 2) {
+    showClusters(u);
+  } else if (op == '<' || op == '>') {
+    kruskalSeek(timelineValid ? kruskalStep + (op == '<' ? -1 : 1)
+                              : (op == '<' ? edgeCount - 1 : edgeCount));
+  } else if (op == '@' && fields >= 2) {
+    kruskalSeek(u);
+  } else if (fields > 0) {
+    Serial.println(F("Commands: + u v w | - u v [w] | k N | < | > | @ step"));
+  }
+}
+
+// 명령 한 줄 읽기 (없으면 false)
+bool readCommandLine(char *line, int size) {
+#ifdef TARGET_PC
+  return std::fgets(line, size, stdin) != nullptr;
+#else
+  if (Serial.available() <= 0)
+    return false;
+  int n = Serial.readBytesUntil('\n', line, size - 1);
+  line[n] = '\0';
+  return true;
+#endif
+}
+
+// ============================================================================
+// 8. 단일 연결 k-클러스터링
+// ============================================================================
+// 가중치 순서대로 합치다가 집합이 k개가 되면 멈춤 (n-k번 합침)
+// = MST에서 가장 무거운 간선 k-1개를 끊은 것. 클러스터마다 다른 색으로 표시
+// 명령: "k N" (시리얼 한 줄). 큰 그래프/점 집합은 --graph/--emst ... --clusters K
+
+#define CLUSTER_K 3 // setup()에서 MST 다음에 보여줄 클러스터 수 (0이면 생략)
+#define CLUSTER_COLORS 6
+
+const uint8_t clusterPalette[CLUSTER_COLORS][3] = {
+    {255, 0, 0}, {0, 255, 0}, {0, 80, 255}, {255, 200, 0}, {255, 0, 255}, {0, 255, 255}};
+
+int clusterOf[MAX_NODES];    // 노드별 클러스터 번호
+bool clusterEdge[MAX_EDGES]; // 클러스터 안에서 합친 간선
+
+// 실제 클러스터 수 반환 (그래프가 k개보다 많은 조각이면 조각 수)
+// edges[] 순서와 inMST[]는 그대로 둠 (간선 번호만 가중치 순으로 정렬)
+int kruskalClusters(int k) {
+  PHASE_SCOPE(PHASE_ALGO);
+  uint16_t order[MAX_EDGES];
+  edges.weightOrder(order, edgeCount);
+
+  finishTimeline(); // sets를 빌려 씀
+  sets.resize(nodeCount);
+  int setsLeft = nodeCount;
+  for (int i = 0; i < edgeCount; i++) {
+    clusterEdge[i] = false;
+  }
+  for (int j = 0; j < edgeCount && setsLeft > k; j++) {
+    int i = order[j];
+    if (sets.unite(edges.u[i], edges.v[i])) {
+      clusterEdge[i] = true;
+      setsLeft--;
+    }
+  }
+
+  // 라벨: 노드 번호 순으로 처음 나온 집합부터 0, 1, 2, ...
+  int rootLabel[MAX_NODES];
+  for (int v = 0; v < nodeCount; v++) {
+    rootLabel[v] = -1;
+  }
+  int clusters = 0;
+  for (int v = 0; v < nodeCount; v++) {
+    int root = sets.find(v);
+    if (rootLabel[root] < 0)
+      rootLabel[root] = clusters++;
+    clusterOf[v] = rootLabel[root];
+  }
+  return clusters;
+}
+
+// 클러스터 안 간선은 클러스터 색(어둡게), 노드는 클러스터 색, 나머지 간선은 흐리게
+void drawClusters() {
+  PHASE_SCOPE(PHASE_RENDER);
+  clearDisplay();
+  for (int i = 0; i < edgeCount; i++) {
+    if (!clusterEdge[i])
+      drawEdge(edges.u[i], edges.v[i], 4);
+  }
+  for (int i = 0; i < edgeCount; i++) {
+    if (!clusterEdge[i])
+      continue;
+    const uint8_t *c = clusterPalette[clusterOf[edges.u[i]] % CLUSTER_COLORS];
+    drawLine(nodes[edges.u[i]].x, nodes[edges.u[i]].y, nodes[edges.v[i]].x,
+             nodes[edges.v[i]].y, c[0] / 4, c[1] / 4, c[2] / 4);
+  }
+  for (int v = 0; v < nodeCount; v++) {
+    const uint8_t *c = clusterPalette[clusterOf[v] % CLUSTER_COLORS];
+    setPixel(nodes[v].x, nodes[v].y, c[0], c[1], c[2]);
+  }
+  showDisplay();
+}
+
+void serialPrintClusters(int clusters) {
+  for (int c = 0; c < clusters; c++) {
+    Serial.print(F("  Cluster "));
+    Serial.print(c);
+    Serial.print(F(":"));
+    for (int v = 0; v < nodeCount; v++) {
+      if (clusterOf[v] == c) {
+        Serial.print(F(" "));
+        Serial.print(v);
+      }
+    }
+    Serial.println();
+  }
+  // 클러스터 사이 가장 가벼운 간선 = 다음에 합쳐질 간선 (spacing)
+  int spacing = -1;
+  for (int i = 0; i < edgeCount; i++) {
+    if (clusterOf[edges.u[i]] != clusterOf[edges.v[i]] &&
+        (spacing < 0 || edges.w[i] < edges.w[spacing]))
+      spacing = i;
+  }
+  if (spacing >= 0) {
+    Serial.print(F("  Spacing: "));
+    Serial.println(edges.w[spacing]);
+  }
+}
+
+void showClusters(int k) {
+  if (k < 1 || k > nodeCount) {
+    Serial.println(F("  -> k must be 1..nodeCount"));
+    return;
+  }
+  Serial.print(F("\n=== Single-linkage clustering (k="));
+  Serial.print(k);
+  Serial.println(F(") ==="));
+  int clusters = kruskalClusters(k);
+  serialPrintClusters(clusters);
+  drawClusters();
+  hardwareDelay(3000);
+}
+
+// ============================================================================
+// 9. Setup & Loop
 // ============================================================================
 
 void setup() {
@@ -631,16 +1326,381 @@ void setup() {
 
   hardwareDelay(1000);
   kruskalMST();
+  if (CLUSTER_K > 0)
+    showClusters(CLUSTER_K);
 }
 
 void loop() {
-  // 알고리즘 완료 후 대기
-  hardwareDelay(1000);
+  // 알고리즘 완료 후 간선 추가/삭제 명령 대기
+  char line[24];
+  if (readCommandLine(line, sizeof(line)))
+    handleEdgeCommand(line);
+  else
+    delay(20); // 대기 중 폴링은 프레임이 아니므로 페이싱에 넣지 않음
 }
 
+// ============================================================================
+// 10. 헤드리스 모드 (PC 전용): ./graph_kruskal --graph FILE [--filter [N] | --lazy | --heatmap] [--verify]
+// ============================================================================
+// DIMACS / SNAP / 바이너리 그래프를 읽어 시각화 없이 MST만 계산
+// ./graph_kruskal --emst [POINTS]: 좌표("x y" 줄)로 유클리드 MST, 파일 없으면 데모 좌표
+// --filter: 병렬 Filter-Kruskal (N = 스레드 수, 생략하면 코어 수)
+// --lazy: 지연 정렬 Kruskal (트리가 완성되면 나머지 간선은 정렬하지 않음)
+// --verify: 결과 트리를 사이클 성질로 검증 (mst_verify.h, 실패하면 종료 코드 2)
+// --clusters K [--labels OUT]: 단일 연결 k-클러스터링 (--emst POINTS 뒤에도 사용 가능)
+//   OUT에는 한 줄에 노드 하나씩 클러스터 번호
+// --external [MB] [--tmp DIR] [--tree OUT]: 그래프 전체를 메모리에 올리지 않는 외부 정렬 Kruskal
+//   MB = 런 버퍼 예산 (기본 64), DIR = 런 파일 위치 (기본 /tmp), OUT = 트리 간선 파일
+// ./graph_kruskal --live: 시각화 후 stdin의 "+ u v w" / "- u v" / "k N" / "<" / ">" / "@ N" 명령을 처리
+// --heatmap: 큰 그래프의 진행을 16x16 칸별 밀도로 애니메이션 (--emst POINTS 뒤에도 사용 가능)
+//   칸 밝기 = 채택된 트리 간선 끝점 / (2 x 칸의 노드 수), 바뀐 칸만 다시 칠함
+// ./graph_kruskal --show FILE [--live]: 작은 그래프 파일(노드 MAX_NODES개 이하)을
+//   graph_layout.h로 캔버스에 배치한 뒤 nodes[]/edges[] 대신 시각화
+
 #ifdef TARGET_PC
-int main() {
+static double headlessMs() {
+  using namespace std::chrono;
+  return duration_cast<duration<double, std::milli>>(
+             steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// filterThreads < 0이면 순차 Kruskal (lazy면 지연 정렬 Kruskal)
+int runHeadless(const char *path, int filterThreads, bool lazy, bool verify) {
+  EdgeList graph;
+  double t0 = headlessMs();
+  if (!loadGraph(path, graph))
+    return 1;
+  double t1 = headlessMs();
+  std::printf("GRAPH: nodes=%u edges=%zu load_ms=%.1f\n", graph.nodeCount,
+              graph.size(), t1 - t0);
+
+  MstResult result;
+  const char *algo;
+  if (filterThreads >= 0) {
+    filterKruskalMST(graph, result, (unsigned)filterThreads);
+    algo = "filter-kruskal";
+  } else if (lazy) {
+    lazyKruskalMST(graph, result);
+    algo = "lazy-kruskal";
+  } else {
+    kruskalMST(graph, result);
+    algo = "kruskal";
+  }
+  double mstMs = headlessMs() - t1;
+  std::printf("MST: algo=%s tree_edges=%zu weight=%lld components=%u "
+              "examined=%llu unexamined=%llu mst_ms=%.1f\n",
+              algo, result.edgeIds.size(), (long long)result.weight,
+              result.components, (unsigned long long)result.examined,
+              (unsigned long long)(graph.size() - result.examined), mstMs);
+  if (!verify)
+    return 0;
+  t1 = headlessMs();
+  MstVerifyResult check = verifyMst(graph, result.edgeIds);
+  std::printf("VERIFY: %s checked=%llu violations=%llu verify_ms=%.1f\n",
+              check.error ? check.error : check.ok ? "ok" : "not minimal",
+              (unsigned long long)check.checked,
+              (unsigned long long)check.violations, headlessMs() - t1);
+  if (check.violations) {
+    const uint32_t id = check.firstViolation;
+    std::printf("VERIFY: edge %u-%u w=%d is lighter than tree path max %d\n",
+                graph.u[id], graph.v[id], graph.w[id], check.firstPathMax);
+  }
+  return check.ok ? 0 : 2;
+}
+
+int runExternal(const char *path, size_t memoryMb, const char *tmpDir,
+                const char *treePath) {
+  FILE *tree = nullptr;
+  if (treePath && !(tree = std::fopen(treePath, "w"))) {
+    std::fprintf(stderr, "cannot create %s\n", treePath);
+    return 1;
+  }
+  ExternalStats stats;
+  bool ok;
+  {
+    ExternalKruskal external(memoryMb << 20, tmpDir);
+    ok = external.run(path, tree, stats);
+  }
+  if (tree)
+    std::fclose(tree);
+  if (!ok)
+    return 1;
+  const double mb = 1.0 / (1 << 20);
+  std::printf("EXTERNAL: nodes=%u edges=%llu runs=%u merge_passes=%u "
+              "buffer_mb=%.1f union_find_mb=%.1f\n",
+              stats.nodeCount, (unsigned long long)stats.edges, stats.runs,
+              stats.mergePasses, stats.bufferBytes * mb,
+              stats.unionFindBytes * mb);
+  std::printf("IO: input_mb=%.1f run_write_mb=%.1f run_read_mb=%.1f "
+              "run_ms=%.1f merge_ms=%.1f\n",
+              stats.inputBytes * mb, stats.runBytesWritten * mb,
+              stats.runBytesRead * mb, stats.runMs, stats.mergeMs);
+  std::printf("MST: algo=external-kruskal tree_edges=%u weight=%lld "
+              "components=%u examined=%llu\n",
+              stats.treeEdges, (long long)stats.weight,
+              stats.nodeCount - stats.treeEdges,
+              (unsigned long long)stats.streamed);
+  return 0;
+}
+
+// --show: 파일을 nodes[]/edges[]로 옮기고 좌표는 힘 기반 배치로 정함
+bool loadShowGraph(const char *path) {
+  EdgeList graph;
+  if (!loadGraph(path, graph))
+    return false;
+  uint32_t loops = 0;
+  for (size_t i = 0; i < graph.size(); i++)
+    loops += graph.u[i] == graph.v[i];
+  if (graph.nodeCount > MAX_NODES || graph.size() - loops > MAX_EDGES) {
+    std::fprintf(stderr, "--show: %u nodes / %zu edges, limit %d / %d\n",
+                 graph.nodeCount, graph.size() - loops, MAX_NODES, MAX_EDGES);
+    return false;
+  }
+  LedLayout layout;
+  LayoutStats stats;
+  layoutGraph(graph, LED_WIDTH, LED_HEIGHT, layout, stats);
+  nodeCount = (int)graph.nodeCount;
+  for (int v = 0; v < nodeCount; v++) {
+    nodes[v].x = layout.x[v];
+    nodes[v].y = layout.y[v];
+  }
+  edgeCount = 0;
+  for (size_t i = 0; i < graph.size(); i++) {
+    if (graph.u[i] == graph.v[i])
+      continue; // 자기 루프는 MST와 무관하고 그릴 수도 없음
+    edges.set(edgeCount++, (uint8_t)graph.u[i], (uint8_t)graph.v[i],
+              graph.w[i]);
+  }
+  std::printf("LAYOUT: nodes=%d edges=%d canvas=%dx%d iterations=%u "
+              "force_ms=%.1f place_ms=%.1f moved=%u overlaps=%u untangled=%u "
+              "edge_node_hits=%u\n",
+              nodeCount, edgeCount, LED_WIDTH, LED_HEIGHT, stats.iterations,
+              stats.forceMs, stats.placeMs, stats.moved, stats.overlaps,
+              stats.untangled, stats.edgeNodeHits);
+  return true;
+}
+
+// 클러스터 요약 + 라벨 파일. squared면 가중치가 제곱거리 (EMST 후보)
+int reportClusters(const EdgeList &graph, const ClusterResult &clusters,
+                   uint32_t k, double ms, const char *labelsPath, bool squared) {
+  uint32_t largest = 0, smallest = clusters.clusters() ? UINT32_MAX : 0;
+  for (uint32_t c = 0; c < clusters.clusters(); c++) {
+    if (clusters.sizes[c] > largest)
+      largest = clusters.sizes[c];
+    if (clusters.sizes[c] < smallest)
+      smallest = clusters.sizes[c];
+  }
+  std::printf("CLUSTERS: k=%u clusters=%u cut_edges=%u largest=%u smallest=%u "
+              "cluster_ms=%.1f",
+              k, clusters.clusters(), clusters.cutEdges, largest, smallest, ms);
+  if (clusters.spacingEdge != CLUSTER_NONE) {
+    const int32_t w = graph.w[clusters.spacingEdge];
+    if (squared)
+      std::printf(" spacing=%.2f", std::sqrt((double)w));
+    else
+      std::printf(" spacing=%d", w);
+  }
+  std::printf("\n");
+  return !labelsPath || writeClusterLabels(labelsPath, clusters) ? 0 : 1;
+}
+
+int runClusters(const char *path, uint32_t k, const char *labelsPath) {
+  EdgeList graph;
+  double t0 = headlessMs();
+  if (!loadGraph(path, graph))
+    return 1;
+  double t1 = headlessMs();
+  std::printf("GRAPH: nodes=%u edges=%zu load_ms=%.1f\n", graph.nodeCount,
+              graph.size(), t1 - t0);
+  ClusterResult clusters;
+  kruskalClusters(graph, k, clusters);
+  return reportClusters(graph, clusters, k, headlessMs() - t1, labelsPath,
+                        false);
+}
+
+// 점 집합: EMST 후보 그래프의 트리에서 무거운 간선 k-1개를 끊음
+int runEmstClusters(const char *path, uint32_t k, const char *labelsPath) {
+  PointSet pts;
+  if (!loadPoints(path, pts))
+    return 1;
+  double t0 = headlessMs();
+  EdgeList candidates;
+  MstResult tree;
+  EmstStats stats;
+  if (!euclideanMST(pts, candidates, tree, stats))
+    return 1;
+  double t1 = headlessMs();
+  std::printf("EMST: points=%zu candidates=%zu length=%.2f emst_ms=%.1f\n",
+              pts.size(), candidates.size(), stats.length, t1 - t0);
+  ClusterResult clusters;
+  forestClusters(candidates, tree.edgeIds, k, clusters);
+  return reportClusters(candidates, clusters, k, headlessMs() - t1, labelsPath,
+                        true);
+}
+
+// --heatmap: 채택 간선이 (V-1)/HEAT_FRAMES개 늘 때마다 바뀐 칸만 칠하고 프레임 출력
+struct HeatmapFrames {
+  LedHeatmap &heat;
+  const EdgeList &graph;
+  uint32_t stride;
+  uint32_t untilFrame;
+
+  void onAccept(uint32_t id) {
+    heat.addEdge(graph.u[id], graph.v[id]);
+    if (--untilFrame == 0) {
+      untilFrame = stride;
+      heat.flush(setPixel);
+      showDisplay();
+    }
+  }
+};
+
+// layout: 노드별 좌표 (범위 무관, 칸으로 모음)
+int runHeatmap(const EdgeList &graph, const LedLayout &layout) {
+  LedHeatmap heat(LED_WIDTH, LED_HEIGHT);
+  heat.bind(layout.x, layout.y, true);
+  clearDisplay();
+  heat.flush(setPixel); // 첫 프레임: 노드가 있는 칸 (그래프 윤곽)
+  showDisplay();
+
+  const uint32_t n = graph.nodeCount;
+  const uint32_t stride = n > HEAT_FRAMES ? (n - 1) / HEAT_FRAMES : 1;
+  HeatmapFrames frames{heat, graph, stride, stride};
+  MstResult result;
+  double t0 = headlessMs();
+  kruskalMST(graph, result, frames);
+  if (heat.pending()) {
+    heat.flush(setPixel);
+    showDisplay();
+  }
+  double ms = headlessMs() - t0;
+
+  const HeatStats &st = heat.stats();
+  std::printf("MST: algo=kruskal tree_edges=%zu weight=%lld components=%u "
+              "mst_ms=%.1f\n",
+              result.edgeIds.size(), (long long)result.weight,
+              result.components, ms);
+  std::printf("HEATMAP: cells=%u occupied=%u frames=%u events=%llu "
+              "repaints=%llu repaints_per_frame=%.1f\n",
+              LED_COUNT, st.occupied, st.frames,
+              (unsigned long long)st.events, (unsigned long long)st.repaints,
+              st.frames ? (double)st.repaints / st.frames : 0.0);
+  return 0;
+}
+
+int runGraphHeatmap(const char *path) {
+  EdgeList graph;
+  double t0 = headlessMs();
+  if (!loadGraph(path, graph))
+    return 1;
+  double t1 = headlessMs();
+  std::printf("GRAPH: nodes=%u edges=%zu load_ms=%.1f\n", graph.nodeCount,
+              graph.size(), t1 - t0);
+  LedLayout layout;
+  uint32_t iterations = heatmapLayout(graph, layout);
+  std::printf("LAYOUT: iterations=%u layout_ms=%.1f\n", iterations,
+              headlessMs() - t1);
+  return runHeatmap(graph, layout);
+}
+
+// 점 집합: 좌표를 그대로 쓰고 EMST 후보 그래프에서 Kruskal을 다시 돌리며 그림
+int runEmstHeatmap(const char *path) {
+  PointSet pts;
+  if (!loadPoints(path, pts))
+    return 1;
+  double t0 = headlessMs();
+  EdgeList candidates;
+  MstResult tree;
+  EmstStats stats;
+  if (!euclideanMST(pts, candidates, tree, stats))
+    return 1;
+  std::printf("EMST: points=%zu candidates=%zu length=%.2f emst_ms=%.1f\n",
+              pts.size(), candidates.size(), stats.length, headlessMs() - t0);
+  LedLayout layout;
+  layout.x = pts.x;
+  layout.y = pts.y;
+  return runHeatmap(candidates, layout);
+}
+
+// 인자 "--clusters K [--labels OUT]"가 argv[i]부터 있으면 true
+bool parseClusterArgs(int argc, char **argv, int i, uint32_t &k,
+                      const char *&labelsPath) {
+  if (i + 1 >= argc || std::strcmp(argv[i], "--clusters") != 0)
+    return false;
+  k = (uint32_t)std::atoi(argv[i + 1]);
+  labelsPath = nullptr;
+  if (i + 3 < argc && std::strcmp(argv[i + 2], "--labels") == 0)
+    labelsPath = argv[i + 3];
+  return true;
+}
+
+// --emst [POINTS]: 좌표로 유클리드 MST 계산
+// 파일을 주지 않으면 nodes[] 좌표를 쓰고, edges[] 가중치 표도 좌표와 대조
+int runEmst(const char *path) {
+  PointSet pts;
+  if (path)
+    return loadPoints(path, pts) ? printEuclideanMST(pts, false) : 1;
+  for (int i = 0; i < nodeCount; i++)
+    pts.add(nodes[i].x, nodes[i].y);
+  // 가중치 표가 좌표와 어긋나면 실패로 끝냄 (EMST 자체는 그래도 출력)
+  int mismatches = checkWeightTable(nodes, nodeCount, edges, edgeCount);
+  int rc = printEuclideanMST(pts, true);
+  return mismatches > 0 ? 1 : rc;
+}
+
+int main(int argc, char **argv) {
+  uint32_t clusterK;
+  const char *labelsPath;
+  if (argc >= 2 && std::strcmp(argv[1], "--emst") == 0) {
+    if (parseClusterArgs(argc, argv, 3, clusterK, labelsPath))
+      return runEmstClusters(argv[2], clusterK, labelsPath);
+    if (argc >= 4 && std::strcmp(argv[3], "--heatmap") == 0)
+      return runEmstHeatmap(argv[2]);
+    return runEmst(argc >= 3 ? argv[2] : nullptr);
+  }
+  if (argc >= 3 && std::strcmp(argv[1], "--graph") == 0) {
+    if (parseClusterArgs(argc, argv, 3, clusterK, labelsPath))
+      return runClusters(argv[2], clusterK, labelsPath);
+    if (argc >= 4 && std::strcmp(argv[3], "--heatmap") == 0)
+      return runGraphHeatmap(argv[2]);
+    int filterThreads = -1;
+    bool verify = std::strcmp(argv[argc - 1], "--verify") == 0;
+    if (verify)
+      argc--;
+    if (argc >= 4 && std::strcmp(argv[3], "--filter") == 0)
+      filterThreads = argc >= 5 ? std::atoi(argv[4]) : 0;
+    if (argc >= 4 && std::strcmp(argv[3], "--external") == 0) {
+      // 검증은 그래프 전체를 메모리에 올려야 하므로 외부 메모리 모드와 함께 쓸 수 없음
+      if (verify) {
+        std::fprintf(stderr, "--verify needs the in-memory graph; "
+                             "it cannot be combined with --external\n");
+        return 1;
+      }
+      size_t memoryMb = 64;
+      const char *tmpDir = nullptr, *treePath = nullptr;
+      for (int i = 4; i < argc; i++) {
+        if (std::strcmp(argv[i], "--tmp") == 0 && i + 1 < argc)
+          tmpDir = argv[++i];
+        else if (std::strcmp(argv[i], "--tree") == 0 && i + 1 < argc)
+          treePath = argv[++i];
+        else
+          memoryMb = (size_t)std::atoi(argv[i]);
+      }
+      return runExternal(argv[2], memoryMb, tmpDir, treePath);
+    }
+    bool lazy = argc >= 4 && std::strcmp(argv[3], "--lazy") == 0;
+    return runHeadless(argv[2], filterThreads, lazy, verify);
+  }
+  if (argc >= 3 && std::strcmp(argv[1], "--show") == 0 &&
+      !loadShowGraph(argv[2]))
+    return 1;
   setup();
+  if (argc >= 2 && std::strcmp(argv[argc - 1], "--live") == 0) {
+    char line[24];
+    while (readCommandLine(line, sizeof(line)))
+      handleEdgeCommand(line);
+  }
   return 0;
 }
 #endif
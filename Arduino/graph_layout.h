@@ -0,0 +1,507 @@
+// 힘 기반(force-directed) 그래프 배치 - PC 전용
+// 좌표가 없는 그래프(--graph 파일 등)를 width x height LED 캔버스 위 정수 좌표로 배치
+//   1) Fruchterman–Reingold: 간선은 당기고(d^2/k), 가까운 쌍은 밀어냄(k^2/d)
+//      반발력은 한 변 2k인 격자 칸에 노드를 담아 이웃 9칸만 봄 -> 반복당 O(n + m)
+//      (2k보다 먼 쌍은 무시, 노드가 몰린 칸은 무게중심 하나로 근사,
+//       연결 요소가 흩어지지 않게 중심 방향으로 약하게 당김)
+//      시작 위치: BFS 순서로 Hilbert 곡선을 따라 깔아 이웃끼리 가깝게 시작
+//      (무작위 시작은 간선 인력에 한가운데로 뭉쳐 격자 칸이 붐빔)
+//   2) 양자화: 결과를 캔버스에 맞게 늘려 픽셀로 반올림. 이미 찬 픽셀이면
+//      가장 가까운 빈 픽셀로 옮김 (고리 모양으로 넓혀가며 탐색)
+//   3) 정리: 다른 간선이 지나가는(Bresenham 선, drawLine()과 같음) 픽셀의 노드를
+//      주변 빈 픽셀로 옮겨 "간선이 노드를 관통"하는 경우를 줄임
+// 같은 입력이면 같은 배치 (난수 없음)
+
+#ifndef GRAPH_LAYOUT_H
+#define GRAPH_LAYOUT_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "graph_edges.h"
+
+#define LAYOUT_ITERATIONS 300
+#define LAYOUT_GRAVITY 0.02f       // 중심 방향 인력 (k 단위)
+#define LAYOUT_CELL_EXACT 16       // 칸에 이보다 많으면 무게중심으로 근사
+#define LAYOUT_UNTANGLE_SWEEPS 3   // 정리 단계 반복 (개선이 없으면 일찍 끝남)
+#define LAYOUT_UNTANGLE_RADIUS 2   // 정리 단계에서 옮겨 볼 범위 (픽셀)
+#define LAYOUT_NONE UINT32_MAX
+
+struct LayoutStats {
+  uint32_t iterations = 0;
+  uint32_t moved = 0;        // 충돌 해소로 반올림 위치에서 옮긴 노드 수
+  uint32_t overlaps = 0;     // 빈 픽셀이 모자라 다른 노드와 겹친 노드 수
+  uint32_t untangled = 0;    // 정리 단계에서 옮긴 횟수
+  uint32_t edgeNodeHits = 0; // 끝점이 아닌 노드를 지나는 (간선, 노드) 쌍 수
+  double forceMs = 0;
+  double placeMs = 0;
+};
+
+// 노드별 정수 픽셀 좌표
+struct LedLayout {
+  std::vector<int32_t> x, y;
+};
+
+class GraphLayout {
+public:
+  GraphLayout(const EdgeList &edges, int width, int height)
+      : edges_(edges), n_(edges.nodeCount), width_(width), height_(height) {}
+
+  void run(LedLayout &out, LayoutStats &stats,
+           uint32_t iterations = LAYOUT_ITERATIONS) {
+    stats = LayoutStats();
+    double t0 = nowMs();
+    buildIncidence();
+    relax(iterations, stats);
+    double t1 = nowMs();
+    stats.forceMs = t1 - t0;
+    quantize(out, stats);
+    untangle(out, stats);
+    stats.placeMs = nowMs() - t1;
+  }
+
+  // 충돌 해소/정리 없이 반올림만 (graph_heatmap.h처럼 여러 노드를 한 칸에 모을 때)
+  void runCoarse(LedLayout &out, LayoutStats &stats, uint32_t iterations) {
+    stats = LayoutStats();
+    double t0 = nowMs();
+    buildIncidence();
+    relax(iterations, stats);
+    out.x.resize(n_);
+    out.y.resize(n_);
+    for (uint32_t v = 0; v < n_; v++) {
+      out.x[v] = (int32_t)px_[v];
+      out.y[v] = (int32_t)py_[v];
+    }
+    stats.forceMs = nowMs() - t0;
+  }
+
+private:
+  static double nowMs() {
+    using namespace std::chrono;
+    return duration_cast<duration<double, std::milli>>(
+               steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  // 노드별 인접 간선 (자기 루프 제외)
+  void buildIncidence() {
+    incStart_.assign((size_t)n_ + 1, 0);
+    for (size_t i = 0; i < edges_.size(); i++) {
+      if (edges_.u[i] == edges_.v[i])
+        continue;
+      incStart_[edges_.u[i] + 1]++;
+      incStart_[edges_.v[i] + 1]++;
+    }
+    for (uint32_t v = 0; v < n_; v++)
+      incStart_[v + 1] += incStart_[v];
+    incEdge_.resize(incStart_[n_]);
+    std::vector<uint32_t> fill(incStart_.begin(), incStart_.end() - 1);
+    for (size_t i = 0; i < edges_.size(); i++) {
+      if (edges_.u[i] == edges_.v[i])
+        continue;
+      incEdge_[fill[edges_.u[i]]++] = (uint32_t)i;
+      incEdge_[fill[edges_.v[i]]++] = (uint32_t)i;
+    }
+  }
+
+  // Hilbert 곡선 (side x side, side는 2의 거듭제곱) 위 d번째 칸
+  static void hilbertCell(uint32_t side, uint64_t d, uint32_t &x, uint32_t &y) {
+    x = 0;
+    y = 0;
+    for (uint32_t s = 1; s < side; s <<= 1) {
+      const uint32_t rx = 1 & (uint32_t)(d / 2), ry = 1 & ((uint32_t)d ^ rx);
+      if (ry == 0) {
+        if (rx == 1) {
+          x = s - 1 - x;
+          y = s - 1 - y;
+        }
+        const uint32_t t = x;
+        x = y;
+        y = t;
+      }
+      x += s * rx;
+      y += s * ry;
+      d /= 4;
+    }
+  }
+
+  // BFS 순서(연결 요소마다)로 Hilbert 곡선 칸을 고르게 나눠 줌
+  void initialPositions(float w, float h) {
+    std::vector<uint32_t> bfs;
+    bfs.reserve(n_);
+    std::vector<char> seen(n_, 0);
+    for (uint32_t root = 0; root < n_; root++) {
+      if (seen[root])
+        continue;
+      seen[root] = 1;
+      size_t head = bfs.size();
+      bfs.push_back(root);
+      while (head < bfs.size()) {
+        const uint32_t x = bfs[head++];
+        for (uint32_t k = incStart_[x]; k < incStart_[x + 1]; k++) {
+          const uint32_t e = incEdge_[k];
+          const uint32_t y = edges_.u[e] == x ? edges_.v[e] : edges_.u[e];
+          if (!seen[y]) {
+            seen[y] = 1;
+            bfs.push_back(y);
+          }
+        }
+      }
+    }
+    uint32_t side = 1;
+    while ((uint64_t)side * side < n_)
+      side <<= 1;
+    const uint64_t cells = (uint64_t)side * side;
+    for (uint32_t i = 0; i < n_; i++) {
+      uint32_t hx, hy;
+      hilbertCell(side, (uint64_t)i * cells / n_, hx, hy);
+      px_[bfs[i]] = (hx + 0.5f) / side * w;
+      py_[bfs[i]] = (hy + 0.5f) / side * h;
+    }
+  }
+
+  // ==========================================================================
+  // 1. 힘 기반 반복 (연속 좌표, 캔버스 [0, width] x [0, height])
+  // ==========================================================================
+
+  void relax(uint32_t iterations, LayoutStats &stats) {
+    px_.resize(n_);
+    py_.resize(n_);
+    const float w = (float)width_, h = (float)height_;
+    const float cx = w / 2, cy = h / 2;
+    initialPositions(w, h);
+    if (n_ < 2)
+      return;
+
+    const float k = std::sqrt(w * h / n_); // 이상적인 간선 길이
+    const float k2 = k * k;
+    const float cell = 2 * k;              // 반발력이 닿는 거리
+    const int cellsX = (int)(w / cell) + 1, cellsY = (int)(h / cell) + 1;
+    std::vector<uint32_t> cellStart((size_t)cellsX * cellsY + 1), cellOf(n_),
+        order(n_);
+    std::vector<float> cellSumX((size_t)cellsX * cellsY),
+        cellSumY((size_t)cellsX * cellsY);
+    std::vector<float> dx(n_), dy(n_);
+    const float t0 = (w > h ? w : h) / 8;
+
+    for (uint32_t it = 0; it < iterations; it++) {
+      // 격자 칸별 노드 목록 (counting sort)
+      std::fill(cellStart.begin(), cellStart.end(), 0);
+      for (uint32_t v = 0; v < n_; v++) {
+        int gx = (int)(px_[v] / cell), gy = (int)(py_[v] / cell);
+        gx = gx < 0 ? 0 : (gx >= cellsX ? cellsX - 1 : gx);
+        gy = gy < 0 ? 0 : (gy >= cellsY ? cellsY - 1 : gy);
+        cellOf[v] = (uint32_t)(gy * cellsX + gx);
+        cellStart[cellOf[v] + 1]++;
+      }
+      for (size_t c = 0; c + 1 < cellStart.size(); c++)
+        cellStart[c + 1] += cellStart[c];
+      {
+        std::vector<uint32_t> fill(cellStart.begin(), cellStart.end() - 1);
+        for (uint32_t v = 0; v < n_; v++)
+          order[fill[cellOf[v]]++] = v;
+      }
+      std::fill(cellSumX.begin(), cellSumX.end(), 0.0f);
+      std::fill(cellSumY.begin(), cellSumY.end(), 0.0f);
+      for (uint32_t v = 0; v < n_; v++) {
+        cellSumX[cellOf[v]] += px_[v];
+        cellSumY[cellOf[v]] += py_[v];
+      }
+
+      // 반발력: 이웃 9칸 안, 거리 2k 이하
+      for (uint32_t v = 0; v < n_; v++) {
+        const int gx = (int)(cellOf[v] % cellsX), gy = (int)(cellOf[v] / cellsX);
+        float fx = 0, fy = 0;
+        for (int oy = gy - 1; oy <= gy + 1; oy++) {
+          if (oy < 0 || oy >= cellsY)
+            continue;
+          for (int ox = gx - 1; ox <= gx + 1; ox++) {
+            if (ox < 0 || ox >= cellsX)
+              continue;
+            const uint32_t c = (uint32_t)(oy * cellsX + ox);
+            const uint32_t count = cellStart[c + 1] - cellStart[c];
+            if (count > LAYOUT_CELL_EXACT) {
+              // 붐비는 칸: (자신을 뺀) 무게중심에 질량 count로 근사
+              const bool own = c == cellOf[v];
+              const float mass = (float)(own ? count - 1 : count);
+              const float mx = (cellSumX[c] - (own ? px_[v] : 0)) / mass;
+              const float my = (cellSumY[c] - (own ? py_[v] : 0)) / mass;
+              const float ddx = px_[v] - mx, ddy = py_[v] - my;
+              const float d2 = ddx * ddx + ddy * ddy;
+              if (d2 > 1e-4f) {
+                const float f = mass * k2 / d2;
+                fx += ddx * f;
+                fy += ddy * f;
+              }
+              continue;
+            }
+            for (uint32_t j = cellStart[c]; j < cellStart[c + 1]; j++) {
+              const uint32_t u = order[j];
+              if (u == v)
+                continue;
+              float ddx = px_[v] - px_[u], ddy = py_[v] - py_[u];
+              float d2 = ddx * ddx + ddy * ddy;
+              if (d2 >= cell * cell)
+                continue;
+              if (d2 < 1e-4f) { // 같은 자리: 번호로 정한 방향으로 떼어냄
+                ddx = v < u ? -0.01f : 0.01f;
+                ddy = 0.005f;
+                d2 = ddx * ddx + ddy * ddy;
+              }
+              const float f = k2 / d2; // (k^2 / d) / d: 단위 벡터 곱까지 포함
+              fx += ddx * f;
+              fy += ddy * f;
+            }
+          }
+        }
+        dx[v] = fx - LAYOUT_GRAVITY * (px_[v] - cx);
+        dy[v] = fy - LAYOUT_GRAVITY * (py_[v] - cy);
+      }
+
+      // 인력: 간선마다 d^2 / k
+      for (size_t i = 0; i < edges_.size(); i++) {
+        const uint32_t a = edges_.u[i], b = edges_.v[i];
+        if (a == b)
+          continue;
+        const float ddx = px_[a] - px_[b], ddy = py_[a] - py_[b];
+        const float d = std::sqrt(ddx * ddx + ddy * ddy);
+        const float f = d / k; // (d^2 / k) / d
+        dx[a] -= ddx * f;
+        dy[a] -= ddy * f;
+        dx[b] += ddx * f;
+        dy[b] += ddy * f;
+      }
+
+      // 온도만큼만 이동 (선형 냉각), 캔버스 밖으로 나가지 않게
+      const float t = t0 * (1.0f - (float)it / iterations) + 0.01f;
+      for (uint32_t v = 0; v < n_; v++) {
+        const float len = std::sqrt(dx[v] * dx[v] + dy[v] * dy[v]);
+        if (len > t) {
+          dx[v] *= t / len;
+          dy[v] *= t / len;
+        }
+        px_[v] = clampf(px_[v] + dx[v], 0, w);
+        py_[v] = clampf(py_[v] + dy[v], 0, h);
+      }
+      stats.iterations++;
+    }
+  }
+
+  static float clampf(float v, float lo, float hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+  }
+
+  // ==========================================================================
+  // 2. 양자화 + 충돌 해소
+  // ==========================================================================
+
+  void quantize(LedLayout &out, LayoutStats &stats) {
+    out.x.assign(n_, 0);
+    out.y.assign(n_, 0);
+    pixelNode_.assign((size_t)width_ * height_, LAYOUT_NONE);
+    if (n_ == 0)
+      return;
+
+    // 경계 상자를 캔버스 전체로 늘림 (축마다 따로)
+    float minX = px_[0], maxX = px_[0], minY = py_[0], maxY = py_[0];
+    for (uint32_t v = 1; v < n_; v++) {
+      minX = px_[v] < minX ? px_[v] : minX;
+      maxX = px_[v] > maxX ? px_[v] : maxX;
+      minY = py_[v] < minY ? py_[v] : minY;
+      maxY = py_[v] > maxY ? py_[v] : maxY;
+    }
+    const float sx = maxX > minX ? (width_ - 1) / (maxX - minX) : 0;
+    const float sy = maxY > minY ? (height_ - 1) / (maxY - minY) : 0;
+
+    const uint64_t capacity = (uint64_t)width_ * height_;
+    uint64_t placed = 0;
+    for (uint32_t v = 0; v < n_; v++) {
+      const float tx = sx ? (px_[v] - minX) * sx : (width_ - 1) / 2.0f;
+      const float ty = sy ? (py_[v] - minY) * sy : (height_ - 1) / 2.0f;
+      int x = (int)std::lround(tx), y = (int)std::lround(ty);
+      if (pixelNode_[(size_t)y * width_ + x] != LAYOUT_NONE) {
+        if (placed < capacity && nearestFree(tx, ty, x, y)) {
+          stats.moved++;
+        } else {
+          stats.overlaps++;
+          out.x[v] = x;
+          out.y[v] = y;
+          continue; // 겹친 노드는 픽셀 표에 올리지 않음
+        }
+      }
+      pixelNode_[(size_t)y * width_ + x] = v;
+      placed++;
+      out.x[v] = x;
+      out.y[v] = y;
+    }
+  }
+
+  // (tx, ty)에서 가장 가까운 빈 픽셀. 고리 r의 픽셀은 r - 0.5보다 가까울 수 없으므로
+  // 찾은 거리보다 고리가 멀어지면 멈춤
+  bool nearestFree(float tx, float ty, int &x, int &y) const {
+    const int x0 = x, y0 = y;
+    const int maxR = width_ > height_ ? width_ : height_;
+    float best = -1;
+    for (int r = 1; r <= maxR; r++) {
+      if (best >= 0 && r - 0.5f > best)
+        break;
+      for (int oy = -r; oy <= r; oy++) {
+        for (int ox = -r; ox <= r; ox++) {
+          if (ox != -r && ox != r && oy != -r && oy != r)
+            continue; // 고리 테두리만
+          const int cx = x0 + ox, cy = y0 + oy;
+          if (cx < 0 || cy < 0 || cx >= width_ || cy >= height_ ||
+              pixelNode_[(size_t)cy * width_ + cx] != LAYOUT_NONE)
+            continue;
+          const float d = std::sqrt((cx - tx) * (cx - tx) + (cy - ty) * (cy - ty));
+          if (best < 0 || d < best) {
+            best = d;
+            x = cx;
+            y = cy;
+          }
+        }
+      }
+    }
+    return best >= 0;
+  }
+
+  // ==========================================================================
+  // 3. 간선이 노드를 관통하는 경우 줄이기
+  // ==========================================================================
+  // cover_[p] = 픽셀 p를 끝점이 아닌 위치로 지나는 간선 수
+  // 노드 v의 비용 = v 픽셀의 cover (남의 간선이 v를 관통)
+  //              + v의 간선이 관통하는 다른 노드 수
+  // 노드를 하나씩 빼서 주변 빈 픽셀 중 비용이 가장 낮은 곳으로 (같으면 제자리)
+
+  template <typename Visit>
+  static void bresenham(int x0, int y0, int x1, int y1, const Visit &visit) {
+    int dx = x1 > x0 ? x1 - x0 : x0 - x1;
+    int dy = y1 > y0 ? y1 - y0 : y0 - y1;
+    int sx = x0 < x1 ? 1 : -1, sy = y0 < y1 ? 1 : -1;
+    int err = dx - dy;
+    while (true) {
+      visit(x0, y0);
+      if (x0 == x1 && y0 == y1)
+        break;
+      int e2 = 2 * err;
+      if (e2 > -dy) {
+        err -= dy;
+        x0 += sx;
+      }
+      if (e2 < dx) {
+        err += dx;
+        y0 += sy;
+      }
+    }
+  }
+
+  // 간선 i의 양 끝을 뺀 픽셀
+  template <typename Visit>
+  void interior(const LedLayout &l, uint32_t i, const Visit &visit) const {
+    const int x0 = l.x[edges_.u[i]], y0 = l.y[edges_.u[i]];
+    const int x1 = l.x[edges_.v[i]], y1 = l.y[edges_.v[i]];
+    bresenham(x0, y0, x1, y1, [&](int x, int y) {
+      if ((x != x0 || y != y0) && (x != x1 || y != y1))
+        visit(x, y);
+    });
+  }
+
+  void addCover(const LedLayout &l, uint32_t i, int delta) {
+    interior(l, i, [&](int x, int y) { cover_[(size_t)y * width_ + x] += delta; });
+  }
+
+  // v가 (x, y)에 있을 때 비용 (v의 간선들은 cover_에서 빠진 상태)
+  uint32_t nodeCost(LedLayout &l, uint32_t v, int x, int y) {
+    uint32_t cost = cover_[(size_t)y * width_ + x];
+    const int32_t oldX = l.x[v], oldY = l.y[v];
+    l.x[v] = x;
+    l.y[v] = y;
+    for (uint32_t k = incStart_[v]; k < incStart_[v + 1]; k++) {
+      interior(l, incEdge_[k], [&](int px, int py) {
+        uint32_t w = pixelNode_[(size_t)py * width_ + px];
+        if (w != LAYOUT_NONE && w != v)
+          cost++;
+      });
+    }
+    l.x[v] = oldX;
+    l.y[v] = oldY;
+    return cost;
+  }
+
+  void untangle(LedLayout &l, LayoutStats &stats) {
+    cover_.assign((size_t)width_ * height_, 0);
+    for (size_t i = 0; i < edges_.size(); i++) {
+      if (edges_.u[i] != edges_.v[i])
+        addCover(l, (uint32_t)i, 1);
+    }
+
+    for (int sweep = 0; sweep < LAYOUT_UNTANGLE_SWEEPS; sweep++) {
+      uint32_t movedThisSweep = 0;
+      for (uint32_t v = 0; v < n_; v++) {
+        const size_t at = (size_t)l.y[v] * width_ + l.x[v];
+        if (pixelNode_[at] != v)
+          continue; // 겹친 노드는 건드리지 않음
+        for (uint32_t k = incStart_[v]; k < incStart_[v + 1]; k++)
+          addCover(l, incEdge_[k], -1);
+        pixelNode_[at] = LAYOUT_NONE;
+
+        int bestX = l.x[v], bestY = l.y[v];
+        uint32_t best = nodeCost(l, v, bestX, bestY);
+        for (int oy = -LAYOUT_UNTANGLE_RADIUS; best && oy <= LAYOUT_UNTANGLE_RADIUS;
+             oy++) {
+          for (int ox = -LAYOUT_UNTANGLE_RADIUS; ox <= LAYOUT_UNTANGLE_RADIUS;
+               ox++) {
+            const int x = l.x[v] + ox, y = l.y[v] + oy;
+            if (x < 0 || y < 0 || x >= width_ || y >= height_ ||
+                pixelNode_[(size_t)y * width_ + x] != LAYOUT_NONE)
+              continue;
+            const uint32_t cost = nodeCost(l, v, x, y);
+            if (cost < best) {
+              best = cost;
+              bestX = x;
+              bestY = y;
+            }
+          }
+        }
+        if (bestX != l.x[v] || bestY != l.y[v]) {
+          l.x[v] = bestX;
+          l.y[v] = bestY;
+          movedThisSweep++;
+        }
+        pixelNode_[(size_t)l.y[v] * width_ + l.x[v]] = v;
+        for (uint32_t k = incStart_[v]; k < incStart_[v + 1]; k++)
+          addCover(l, incEdge_[k], 1);
+      }
+      stats.untangled += movedThisSweep;
+      if (movedThisSweep == 0)
+        break;
+    }
+
+    stats.edgeNodeHits = 0;
+    for (size_t p = 0; p < pixelNode_.size(); p++) {
+      if (pixelNode_[p] != LAYOUT_NONE)
+        stats.edgeNodeHits += cover_[p];
+    }
+  }
+
+  const EdgeList &edges_;
+  const uint32_t n_;
+  const int width_, height_;
+  std::vector<uint32_t> incStart_, incEdge_;
+  std::vector<float> px_, py_;
+  std::vector<uint32_t> pixelNode_; // 픽셀 -> 노드 (LAYOUT_NONE: 빈 픽셀)
+  std::vector<uint32_t> cover_;
+};
+
+// 편의 함수: 그래프를 width x height 캔버스에 배치
+inline void layoutGraph(const EdgeList &edges, int width, int height,
+                        LedLayout &out, LayoutStats &stats,
+                        uint32_t iterations = LAYOUT_ITERATIONS) {
+  GraphLayout layout(edges, width, height);
+  layout.run(out, stats, iterations);
+}
+
+#endif
@@ -6,9 +6,17 @@
 #include <chrono>
 #include <cmath>
 #include <cstdint>
+#include <cerrno>
 #include <cstdio>
 #include <math.h>
 #include <thread>
+#include <time.h>
+
+#include "edge_table.h"
+#include "emst.h"        // --emst 유클리드 MST
+#include "graph_csr.h"   // --graph 헤드리스 모드
+#include "graph_heatmap.h" // --heatmap 큰 그래프 진행 히트맵
+#include "mst_engines.h"
 
 #define F(x) x
 #define HEX 16
@@ -26,6 +34,24 @@ void delayMicroseconds(int us) {
   std::this_thread::sleep_for(std::chrono::microseconds(us));
 }
 
+// 단조 시계 (clock_nanosleep TIMER_ABSTIME과 같은 CLOCK_MONOTONIC 기준)
+struct timespec monotonicOrigin() {
+  static struct timespec origin = [] {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts;
+  }();
+  return origin;
+}
+
+unsigned long micros() {
+  struct timespec origin = monotonicOrigin();
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (unsigned long)((long long)(now.tv_sec - origin.tv_sec) * 1000000LL +
+                         (now.tv_nsec - origin.tv_nsec) / 1000);
+}
+
 void pinMode(int pin, int mode) {}
 void digitalWrite(int pin, int value) {}
 int digitalRead(int pin) { return HIGH; }
@@ -41,6 +67,7 @@ struct SerialType {
   void begin(unsigned long) {}
   void print(const char *s) { std::printf("%s", s); }
   void print(int v) { std::printf("%d", v); }
+  void print(unsigned long v) { std::printf("%lu", v); }
   void print(uint8_t v, int base) {
     if (base == HEX)
       std::printf("%x", v); // Arduino prints without leading zeros
@@ -59,6 +86,10 @@ struct SerialType {
     std::printf("%d\n", v);
     std::fflush(stdout);
   }
+  void println(unsigned long v) {
+    std::printf("%lu\n", v);
+    std::fflush(stdout);
+  }
   int available() { return 0; }
   int read() { return -1; }
   int parseInt() { return -1; }
@@ -67,17 +98,43 @@ struct SerialType {
 #define NEO_GRB 0
 #define NEO_KHZ800 0
 
+// WS2812 전송 시간 모델 (800kHz, LED당 24bit x 1.25us)
+// 실제 show()는 전송 동안 인터럽트를 끄므로 시리얼 수신, millis(), 자석 스캔이 멈춤
+#define WS2812_US_PER_LED 30
+#define WS2812_LATCH_US 300        // 래치(reset) 최소 간격 (WS2812B)
+#define WS2812_MILLIS_TICK_US 1024 // AVR timer0 오버플로 주기 (1개만 보류됨)
+#define WS2812_UART_BYTE_US 87     // 115200bps에서 1바이트 수신 시간
+#define WS2812_UART_FIFO 2         // AVR UART 수신 버퍼 (바이트)
+#ifndef WS2812_SIMULATE_TIMING
+#define WS2812_SIMULATE_TIMING 0 // 1이면 show()가 전송 시간만큼 실제로 대기 (-D로 켬)
+#endif
+
 class Adafruit_NeoPixel {
 public:
   Adafruit_NeoPixel(int n, int /*pin*/, int /*flags*/)
-      : _n(n), _brightness(20) {
+      : _n(n), _brightness(20), _shows(0), _busyUs(0), _maxIrqOffUs(0),
+        _lostMillisUs(0), _rxOverrunBytes(0) {
     _pixels = new uint32_t[_n];
     clear();
   }
   ~Adafruit_NeoPixel() { delete[] _pixels; }
 
   void begin() {}
-  void show() {}
+  void show() {
+    unsigned long transferUs = (unsigned long)_n * WS2812_US_PER_LED;
+    _shows++;
+    _busyUs += transferUs;
+    if (transferUs > _maxIrqOffUs)
+      _maxIrqOffUs = transferUs;
+    if (transferUs > WS2812_MILLIS_TICK_US)
+      _lostMillisUs += transferUs - WS2812_MILLIS_TICK_US;
+    unsigned long rxBytes = transferUs / WS2812_UART_BYTE_US;
+    if (rxBytes > WS2812_UART_FIFO)
+      _rxOverrunBytes += rxBytes - WS2812_UART_FIFO;
+#if WS2812_SIMULATE_TIMING
+    delayMicroseconds(transferUs);
+#endif
+  }
   void setBrightness(uint8_t b) { _brightness = b; }
   uint8_t getBrightness() const { return _brightness; }
   void clear() {
@@ -97,16 +154,32 @@ public:
     return 0;
   }
 
+  // 전송 시간 모델 요약: 누적 점유 시간, 최대 인터럽트 차단 구간, 최대 프레임 속도
+  void printTransferStats() const {
+    unsigned long transferUs = (unsigned long)_n * WS2812_US_PER_LED;
+    std::printf("WS2812: leds=%d shows=%lu busy_ms=%lu irq_off_max_us=%lu "
+                "millis_lost_ms=%lu max_fps=%lu rx_overrun_bytes=%lu\n",
+                _n, _shows, _busyUs / 1000, _maxIrqOffUs, _lostMillisUs / 1000,
+                1000000UL / (transferUs + WS2812_LATCH_US), _rxOverrunBytes);
+    std::fflush(stdout);
+  }
+
 private:
   int _n;
   uint8_t _brightness;
   uint32_t *_pixels;
+  unsigned long _shows;
+  unsigned long _busyUs;       // show()에 쓰인 누적 시간
+  unsigned long _maxIrqOffUs;  // 가장 긴 인터럽트 차단 구간
+  unsigned long _lostMillisUs; // 차단 중 놓친 timer0 tick
+  unsigned long _rxOverrunBytes; // 수신이 계속됐다면 차단 중 넘쳤을 UART 바이트
 };
 
 #else
 // ================= 실제 Arduino 빌드용 =================
 #include <Adafruit_NeoPixel.h>
 #include <Arduino.h>
+#include "edge_table.h"
 #ifdef __AVR__
 #include <avr/power.h>
 #endif
@@ -145,6 +218,152 @@ static int currentFrameNumber = 0;
 static uint8_t lastBrightness = 255;
 static float animationSpeed = 1.0;
 
+// 구간별 타이밍 (알고리즘 / 그리기 / 시리얼 출력)
+// -DPROFILE_PHASES=1로 빌드하면 활성화, 아니면 매크로가 모두 빈 코드가 됨
+// 중첩된 구간은 자기 시간만 기록 (예: 그리기 안의 serialPrintFrame은 io로 분리)
+#ifndef PROFILE_PHASES
+#define PROFILE_PHASES 0
+#endif
+
+#if PROFILE_PHASES
+enum Phase { PHASE_ALGO, PHASE_RENDER, PHASE_IO, PHASE_COUNT };
+
+#ifdef TARGET_PC
+#define PHASE_UNIT "ns"
+#define PHASE_SUB_BITS 2 // 2의 거듭제곱 구간을 4칸으로 나눔 (오차 25% 이내)
+static inline uint32_t phaseClock() {
+  return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+#else
+#define PHASE_UNIT "us"
+#define PHASE_SUB_BITS 0 // SRAM 절약: 2의 거듭제곱 단위
+static inline uint32_t phaseClock() { return micros(); }
+#endif
+
+#define PHASE_BUCKETS ((33 - PHASE_SUB_BITS) << PHASE_SUB_BITS)
+
+struct PhaseHistogram {
+  uint32_t count;
+  uint32_t minValue;
+  uint32_t maxValue;
+  uint32_t buckets[PHASE_BUCKETS];
+};
+
+static PhaseHistogram phaseHist[PHASE_COUNT];
+
+// 로그 스케일 버킷 번호
+static uint8_t phaseBucket(uint32_t v) {
+  if (v < (1UL << PHASE_SUB_BITS))
+    return (uint8_t)v;
+  uint8_t msb = 31;
+  while (!(v & (1UL << msb)))
+    msb--;
+  uint8_t sub = (v >> (msb - PHASE_SUB_BITS)) & ((1 << PHASE_SUB_BITS) - 1);
+  return ((msb - PHASE_SUB_BITS + 1) << PHASE_SUB_BITS) + sub;
+}
+
+// 버킷이 담당하는 최대값
+static uint32_t phaseBucketUpper(uint8_t bucket) {
+  if (bucket < (1 << PHASE_SUB_BITS))
+    return bucket;
+  uint8_t msb = (bucket >> PHASE_SUB_BITS) + PHASE_SUB_BITS - 1;
+  uint32_t sub = bucket & ((1 << PHASE_SUB_BITS) - 1);
+  uint32_t lower = (1UL << msb) | (sub << (msb - PHASE_SUB_BITS));
+  return lower + (1UL << (msb - PHASE_SUB_BITS)) - 1;
+}
+
+void phaseRecord(uint8_t phase, uint32_t elapsed) {
+  PhaseHistogram &h = phaseHist[phase];
+  if (h.count == 0 || elapsed < h.minValue)
+    h.minValue = elapsed;
+  if (elapsed > h.maxValue)
+    h.maxValue = elapsed;
+  h.count++;
+  h.buckets[phaseBucket(elapsed)]++;
+}
+
+uint32_t phaseQuantile(uint8_t phase, uint32_t permille) {
+  PhaseHistogram &h = phaseHist[phase];
+  uint32_t rank = (h.count * permille + 999) / 1000;
+  uint32_t seen = 0;
+  for (int i = 0; i < PHASE_BUCKETS; i++) {
+    seen += h.buckets[i];
+    if (seen >= rank && seen > 0) {
+      uint32_t upper = phaseBucketUpper(i);
+      return upper < h.maxValue ? upper : h.maxValue;
+    }
+  }
+  return h.maxValue;
+}
+
+// 스코프 타이머: 생성~소멸 구간을 기록, 안쪽 구간이 열리면 바깥 구간은 잠시 멈춤
+struct PhaseScope {
+  static PhaseScope *active;
+  PhaseScope *parent;
+  uint32_t start;
+  uint32_t elapsed;
+  uint8_t phase;
+  bool merged; // 같은 구간 안에서 다시 열린 경우 바깥 구간에 합침
+
+  explicit PhaseScope(uint8_t p) : parent(active), elapsed(0), phase(p) {
+    merged = parent && parent->phase == p;
+    if (merged)
+      return;
+    start = phaseClock();
+    if (parent)
+      parent->elapsed += start - parent->start;
+    active = this;
+  }
+
+  ~PhaseScope() {
+    if (merged)
+      return;
+    uint32_t now = phaseClock();
+    phaseRecord(phase, elapsed + (now - start));
+    active = parent;
+    if (parent)
+      parent->start = now;
+  }
+};
+
+PhaseScope *PhaseScope::active = 0;
+
+void serialPrintPhaseStats() {
+  static const char *names[PHASE_COUNT] = {"algo", "render", "io"};
+  for (uint8_t p = 0; p < PHASE_COUNT; p++) {
+    Serial.print(F("PHASE:"));
+    Serial.print(names[p]);
+    Serial.print(F(" n="));
+    Serial.print((unsigned long)phaseHist[p].count);
+    Serial.print(F(" min="));
+    Serial.print((unsigned long)phaseHist[p].minValue);
+    Serial.print(F(" p50="));
+    Serial.print((unsigned long)phaseQuantile(p, 500));
+    Serial.print(F(" p99="));
+    Serial.print((unsigned long)phaseQuantile(p, 990));
+    Serial.print(F(" max="));
+    Serial.print((unsigned long)phaseHist[p].maxValue);
+    Serial.println(F(" " PHASE_UNIT));
+  }
+}
+
+// 실행 시작마다 호출: 보고가 그 실행의 구간만 담도록 히스토그램을 비움
+void phaseReset() {
+  for (uint8_t p = 0; p < PHASE_COUNT; p++)
+    phaseHist[p] = PhaseHistogram();
+}
+
+#define PHASE_SCOPE(p) PhaseScope phaseScope(p)
+#define PHASE_REPORT() serialPrintPhaseStats()
+#define PHASE_RESET() phaseReset()
+#else
+#define PHASE_SCOPE(p)
+#define PHASE_REPORT()
+#define PHASE_RESET()
+#endif
+
 void printHex(uint8_t value) {
   if (value < 16)
     Serial.print("0");
@@ -152,6 +371,7 @@ void printHex(uint8_t value) {
 }
 
 void serialPrintFrame() {
+  PHASE_SCOPE(PHASE_IO);
   Serial.print(F("FRAME:"));
   Serial.println(currentFrameNumber);
 
@@ -188,6 +408,7 @@ void setPixel(int x, int y, uint8_t r, uint8_t g, uint8_t b) {
 void clearDisplay() { strip.clear(); }
 
 void showDisplay() {
+  PHASE_SCOPE(PHASE_IO);
   uint8_t currentBrightness = strip.getBrightness();
   if (currentBrightness != lastBrightness) {
     Serial.print(F("BRIGHTNESS:"));
@@ -201,10 +422,86 @@ void showDisplay() {
 
 void setBrightness(uint8_t level) { strip.setBrightness(level); }
 
+// 프레임 페이싱 (절대 마감 기준)
+// 각 스텝의 목표 표시 시각 = 이전 목표 시각 + 지연 시간
+// 그리기/시리얼 출력 시간이 지연에 더해지지 않으므로 오래 실행해도 오차가 누적되지 않음
+#define PACE_MAX_CATCHUP_US 250000UL // 이보다 늦으면 일정을 현재 시각으로 재설정
+
+static unsigned long frameDeadline = 0; // 다음 프레임 목표 시각 (micros)
+static bool frameDeadlineSet = false;
+static unsigned long pacedFrames = 0;
+static unsigned long lateFrames = 0;
+static unsigned long maxLateUs = 0;
+static unsigned long totalLateUs = 0;
+
+void sleepUntilMicros(unsigned long target) {
+#ifdef TARGET_PC
+  struct timespec ts = monotonicOrigin();
+  ts.tv_sec += target / 1000000UL;
+  ts.tv_nsec += (long)(target % 1000000UL) * 1000L;
+  if (ts.tv_nsec >= 1000000000L) {
+    ts.tv_sec++;
+    ts.tv_nsec -= 1000000000L;
+  }
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+  }
+#else
+  // 대부분은 delay()로 자고 마지막 1ms 정도만 micros()로 맞춤
+  long remaining = (long)(target - micros());
+  if (remaining > 2000)
+    delay((remaining - 1000) / 1000);
+  while ((long)(target - micros()) > 0) {
+  }
+#endif
+}
+
 void hardwareDelay(unsigned long ms) {
   if (animationSpeed <= 0.0)
     animationSpeed = 1.0;
-  delay((unsigned long)(ms / animationSpeed));
+
+  unsigned long now = micros();
+  if (!frameDeadlineSet) {
+    frameDeadline = now;
+    frameDeadlineSet = true;
+  }
+  frameDeadline += (unsigned long)(ms * 1000.0 / animationSpeed);
+  pacedFrames++;
+
+  long slack = (long)(frameDeadline - now);
+  if (slack >= 0) {
+    sleepUntilMicros(frameDeadline);
+    return;
+  }
+
+  // 이미 목표 시각을 지남: 지각 프레임으로 기록
+  unsigned long late = (unsigned long)(-slack);
+  lateFrames++;
+  totalLateUs += late;
+  if (late > maxLateUs)
+    maxLateUs = late;
+  if (late > PACE_MAX_CATCHUP_US)
+    frameDeadline = now;
+}
+
+// 실행마다 새로 시작: 통계를 비우고, 이전 실행이나 그 뒤의 대기 시간이
+// 첫 프레임의 지각으로 잡히지 않도록 일정도 다음 hardwareDelay()에서 다시 잡음
+void pacingReset() {
+  frameDeadlineSet = false;
+  pacedFrames = 0;
+  lateFrames = 0;
+  maxLateUs = 0;
+  totalLateUs = 0;
+}
+
+void serialPrintPacingStats() {
+  Serial.print(F("PACING: frames="));
+  Serial.print(pacedFrames);
+  Serial.print(F(" late="));
+  Serial.print(lateFrames);
+  Serial.print(F(" max_late_us="));
+  Serial.print(maxLateUs);
+  Serial.print(F(" avg_late_us="));
+  Serial.println(lateFrames > 0 ? totalLateUs / lateFrames : 0UL);
 }
 
 void setAnimationSpeed(float speed) { animationSpeed = speed; }
@@ -215,16 +512,15 @@ void setAnimationSpeed(float speed) { animationSpeed = speed; }
 
 #define MAX_NODES 10
 #define MAX_EDGES 25
-#define INF 9999
+#define MAX_ADJ (2 * MAX_EDGES) // 무방향 간선은 양쪽 인접 리스트에 한 번씩
 
 struct NodePos {
   int x, y;
 };
 
-struct Edge {
-  int u, v;
-  int weight;
-};
+// 간선 표: 열(SoA) 3개, 정수 폭은 컴파일 시 선택 (edge_table.h)
+// 데모 그래프는 노드 10개 / 가중치 9 이하라 모두 uint8_t (간선당 3바이트)
+typedef EdgeTable<uint8_t, uint8_t, MAX_EDGES> SketchEdges;
 
 // 10개 노드를 비대칭적으로 배치 (크루스칼과 동일)
 NodePos nodes[MAX_NODES] = {
@@ -240,51 +536,93 @@ NodePos nodes[MAX_NODES] = {
     {7, 4}    // 9
 };
 
-// 인접 행렬로 그래프 표현
-int adjMatrix[MAX_NODES][MAX_NODES];
+// 간선 (크루스칼과 동일한 20개 간선), {u, v, 가중치} 행으로 플래시에 두고 edges로 옮김
+// 가중치 = sqrt((x2-x1)^2 + (y2-y1)^2) 반올림
+const uint8_t demoEdges[][3] PROGMEM = {
+    {0, 1, 8}, // (3,2)-(11,3): sqrt(64+1)=8.06
+    {0, 5, 9}, // (3,2)-(2,11): sqrt(1+81)=9.06
+    {0, 9, 4}, // (3,2)-(7,4): sqrt(16+4)=4.47
+    {1, 2, 5}, // (11,3)-(14,7): sqrt(9+16)=5
+    {1, 9, 4}, // (11,3)-(7,4): sqrt(16+1)=4.12
+    {1, 7, 6}, // (11,3)-(9,9): sqrt(4+36)=6.32
+    {2, 3, 6}, // (14,7)-(13,13): sqrt(1+36)=6.08
+    {2, 8, 4}, // (14,7)-(12,11): sqrt(4+16)=4.47
+    {3, 4, 6}, // (13,13)-(7,14): sqrt(36+1)=6.08
+    {3, 8, 2}, // (13,13)-(12,11): sqrt(1+4)=2.24
+    {4, 5, 6}, // (7,14)-(2,11): sqrt(25+9)=5.83
+    {4, 6, 7}, // (7,14)-(5,7): sqrt(4+49)=7.28
+    {4, 7, 5}, // (7,14)-(9,9): sqrt(4+25)=5.39
+    {5, 6, 5}, // (2,11)-(5,7): sqrt(9+16)=5
+    {6, 7, 4}, // (5,7)-(9,9): sqrt(16+4)=4.47
+    {6, 9, 4}, // (5,7)-(7,4): sqrt(4+9)=3.61
+    {7, 8, 4}, // (9,9)-(12,11): sqrt(9+4)=3.61
+    {7, 9, 5}, // (9,9)-(7,4): sqrt(4+25)=5.39
+    {8, 3, 2}, // 중복 (이미 3-8로 표현)
+    {9, 1, 4}  // 중복 (이미 1-9로 표현)
+};
+
+SketchEdges edges(demoEdges, 20);
 
 int nodeCount = 10;
+int edgeCount = 20;
+
+// 인접 리스트 (CSR): u의 이웃은 adjTarget[adjStart[u]] ~ adjTarget[adjStart[u + 1] - 1]
+// 인접 행렬(V^2)과 달리 메모리와 이웃 순회가 O(V + E)
+int adjStart[MAX_NODES + 1];
+int adjTarget[MAX_ADJ];
+int adjWeight[MAX_ADJ];
 
 void initializeGraph() {
-  // 인접 행렬 초기화 (INF로)
+  // 1. 차수 세기 -> 누적합
+  for (int i = 0; i <= nodeCount; i++) {
+    adjStart[i] = 0;
+  }
+  for (int i = 0; i < edgeCount; i++) {
+    adjStart[edges.u[i] + 1]++;
+    adjStart[edges.v[i] + 1]++;
+  }
+  for (int i = 0; i < nodeCount; i++) {
+    adjStart[i + 1] += adjStart[i];
+  }
+
+  // 2. 채우기 (무방향 그래프)
+  int fill[MAX_NODES];
   for (int i = 0; i < nodeCount; i++) {
-    for (int j = 0; j < nodeCount; j++) {
-      adjMatrix[i][j] = (i == j) ? 0 : INF;
+    fill[i] = adjStart[i];
+  }
+  for (int i = 0; i < edgeCount; i++) {
+    int u = edges.u[i];
+    int v = edges.v[i];
+    adjTarget[fill[u]] = v;
+    adjWeight[fill[u]++] = edges.w[i];
+    adjTarget[fill[v]] = u;
+    adjWeight[fill[v]++] = edges.w[i];
+  }
+
+  // 3. 각 행을 이웃 번호순으로 (인접 행렬을 훑던 것과 같은 갱신 순서)
+  for (int u = 0; u < nodeCount; u++) {
+    for (int k = adjStart[u] + 1; k < adjStart[u + 1]; k++) {
+      int t = adjTarget[k];
+      int w = adjWeight[k];
+      int j = k - 1;
+      while (j >= adjStart[u] && adjTarget[j] > t) {
+        adjTarget[j + 1] = adjTarget[j];
+        adjWeight[j + 1] = adjWeight[j];
+        j--;
+      }
+      adjTarget[j + 1] = t;
+      adjWeight[j + 1] = w;
     }
   }
+}
 
-  // 간선 추가 (크루스칼과 동일한 20개 간선)
-  // 가중치 = sqrt((x2-x1)^2 + (y2-y1)^2) 반올림
-  int edges[][3] = {
-      {0, 1, 8}, // (3,2)-(11,3): sqrt(64+1)=8.06
-      {0, 5, 9}, // (3,2)-(2,11): sqrt(1+81)=9.06
-      {0, 9, 5}, // (3,2)-(7,4): sqrt(16+4)=4.47
-      {1, 2, 5}, // (11,3)-(14,7): sqrt(9+16)=5
-      {1, 9, 4}, // (11,3)-(7,4): sqrt(16+1)=4.12
-      {1, 7, 6}, // (11,3)-(9,9): sqrt(4+36)=6.32
-      {2, 3, 6}, // (14,7)-(13,13): sqrt(1+36)=6.08
-      {2, 8, 5}, // (14,7)-(12,11): sqrt(4+16)=4.47
-      {3, 4, 6}, // (13,13)-(7,14): sqrt(36+1)=6.08
-      {3, 8, 2}, // (13,13)-(12,11): sqrt(1+4)=2.24
-      {4, 5, 6}, // (7,14)-(2,11): sqrt(25+9)=5.83
-      {4, 6, 7}, // (7,14)-(5,7): sqrt(4+49)=7.28
-      {4, 7, 6}, // (7,14)-(9,9): sqrt(4+25)=5.39
-      {5, 6, 5}, // (2,11)-(5,7): sqrt(9+16)=5
-      {6, 7, 5}, // (5,7)-(9,9): sqrt(16+4)=4.47
-      {6, 9, 4}, // (5,7)-(7,4): sqrt(4+9)=3.61
-      {7, 8, 4}, // (9,9)-(12,11): sqrt(9+4)=3.61
-      {7, 9, 6}, // (9,9)-(7,4): sqrt(4+25)=5.39
-      {8, 3, 2}, // 중복 (이미 3-8로 표현)
-      {9, 1, 4}  // 중복 (이미 1-9로 표현)
-  };
-
-  for (int i = 0; i < 20; i++) {
-    int u = edges[i][0];
-    int v = edges[i][1];
-    int w = edges[i][2];
-    adjMatrix[u][v] = w;
-    adjMatrix[v][u] = w; // 무방향 그래프
+// u-v 간선의 가중치 (없으면 -1)
+int edgeWeightBetween(int u, int v) {
+  for (int k = adjStart[u]; k < adjStart[u + 1]; k++) {
+    if (adjTarget[k] == v)
+      return adjWeight[k];
   }
+  return -1;
 }
 
 // ============================================================================
@@ -358,7 +696,7 @@ void drawNode(int nodeId, int color) {
 void drawEdge(int u, int v, int color) {
   if (u < 0 || u >= nodeCount || v < 0 || v >= nodeCount)
     return;
-  if (adjMatrix[u][v] == INF)
+  if (edgeWeightBetween(u, v) < 0)
     return;
 
   uint8_t r, g, b;
@@ -390,13 +728,12 @@ void drawEdge(int u, int v, int color) {
 
 // 전체 그래프 그리기
 void drawGraph() {
-  // 모든 간선 그리기
-  for (int i = 0; i < nodeCount; i++) {
-    for (int j = i + 1; j < nodeCount; j++) {
-      if (adjMatrix[i][j] != INF) {
-        drawEdge(i, j, 0);
-      }
-    }
+  PHASE_SCOPE(PHASE_RENDER);
+  // 모든 간선 그리기 (작은 번호 -> 큰 번호 방향, 선 픽셀이 방향에 따라 다름)
+  for (int i = 0; i < edgeCount; i++) {
+    int u = edges.u[i] < edges.v[i] ? edges.u[i] : edges.v[i];
+    int v = edges.u[i] < edges.v[i] ? edges.v[i] : edges.u[i];
+    drawEdge(u, v, 0);
   }
 
   // 모든 노드 그리기
@@ -417,27 +754,174 @@ void clearAndDrawGraph() {
 
 bool inMST[MAX_NODES];
 int parent[MAX_NODES];
-int key[MAX_NODES];
+int key[MAX_NODES]; // 힙에 들어 있는 노드만 의미 있음
 
-struct MSTEdge {
-  int u, v, weight;
-};
-
-MSTEdge mstEdges[MAX_NODES];
+EdgeTable<uint8_t, uint8_t, MAX_NODES> mstEdges; // 트리 간선 (선택 순서)
 int mstCount = 0;
 
+// 인덱스 d-ary 최소 힙 (decrease-key 지원)
+// 순서: key, 같으면 노드 번호 (전체를 훑어 최솟값을 찾던 것과 같은 선택)
+#define PRIM_HEAP_ARITY 4
+
+int heap[MAX_NODES];
+int heapPos[MAX_NODES]; // heap 안의 위치 (-1: 힙에 없음)
+int heapSize = 0;
+
+bool heapLess(int a, int b) {
+  return key[a] < key[b] || (key[a] == key[b] && a < b);
+}
+
+void heapPlace(int i, int v) {
+  heap[i] = v;
+  heapPos[v] = i;
+}
+
+void heapSiftUp(int i) {
+  int v = heap[i];
+  while (i > 0) {
+    int p = (i - 1) / PRIM_HEAP_ARITY;
+    if (!heapLess(v, heap[p]))
+      break;
+    heapPlace(i, heap[p]);
+    i = p;
+  }
+  heapPlace(i, v);
+}
+
+void heapSiftDown(int i) {
+  int v = heap[i];
+  while (true) {
+    int first = i * PRIM_HEAP_ARITY + 1;
+    if (first >= heapSize)
+      break;
+    int best = first;
+    for (int c = first + 1; c < first + PRIM_HEAP_ARITY && c < heapSize; c++) {
+      if (heapLess(heap[c], heap[best]))
+        best = c;
+    }
+    if (!heapLess(heap[best], v))
+      break;
+    heapPlace(i, heap[best]);
+    i = best;
+  }
+  heapPlace(i, v);
+}
+
+// key[v]를 바꾼 뒤 호출 (힙에 없으면 추가, 있으면 decrease-key)
+void heapPushOrDecrease(int v) {
+  if (heapPos[v] < 0) {
+    heapPlace(heapSize, v);
+    heapSize++;
+  }
+  heapSiftUp(heapPos[v]);
+}
+
+// MST에 포함되지 않은 노드 중 key 값이 최소인 노드 (없으면 -1)
+int extractMinKeyNode() {
+  PHASE_SCOPE(PHASE_ALGO);
+  if (heapSize == 0)
+    return -1;
+  int u = heap[0];
+  heapPos[u] = -1;
+  heapSize--;
+  if (heapSize > 0) {
+    heapPlace(0, heap[heapSize]);
+    heapSiftDown(0);
+  }
+  return u;
+}
+
+// u에 인접한 노드의 key 값 업데이트
+void relaxNeighbors(int u) {
+  PHASE_SCOPE(PHASE_ALGO);
+  for (int k = adjStart[u]; k < adjStart[u + 1]; k++) {
+    int v = adjTarget[k];
+    int w = adjWeight[k];
+    if (!inMST[v] && (heapPos[v] < 0 || w < key[v])) {
+      parent[v] = u;
+      key[v] = w;
+      heapPushOrDecrease(v);
+
+      Serial.print(F("  Update key["));
+      Serial.print(v);
+      Serial.print(F("] = "));
+      Serial.println(key[v]);
+    }
+  }
+}
+
+// 시각화: MST 간선/노드 위에 방금 추가된 노드(빨강) 표시
+void drawPrimAdded(int u) {
+  PHASE_SCOPE(PHASE_RENDER);
+  clearDisplay();
+  drawGraph();
+
+  // MST 간선 표시 (초록색)
+  for (int i = 0; i < mstCount; i++) {
+    drawEdge(mstEdges.u[i], mstEdges.v[i], 2);
+  }
+
+  // MST 노드 표시 (초록색)
+  for (int i = 0; i < nodeCount; i++) {
+    if (inMST[i]) {
+      drawNode(i, 0);
+    }
+  }
+
+  // 현재 추가된 노드 (빨강)
+  drawNode(u, 2);
+
+  showDisplay();
+}
+
+// 시각화: MST 위에 경계 노드/간선(노란색) 표시
+void drawPrimFrontier() {
+  PHASE_SCOPE(PHASE_RENDER);
+  clearDisplay();
+  drawGraph();
+
+  // MST 간선
+  for (int i = 0; i < mstCount; i++) {
+    drawEdge(mstEdges.u[i], mstEdges.v[i], 2);
+  }
+
+  // MST 노드
+  for (int i = 0; i < nodeCount; i++) {
+    if (inMST[i]) {
+      drawNode(i, 0);
+    }
+  }
+
+  // 경계 노드 (힙에 들어 있는 노드) - 노란색
+  for (int v = 0; v < nodeCount; v++) {
+    if (heapPos[v] >= 0) {
+      drawNode(v, 3);
+      // 경계 간선도 노란색으로
+      if (parent[v] != -1) {
+        drawEdge(parent[v], v, 1);
+      }
+    }
+  }
+
+  showDisplay();
+}
+
 void primMST() {
+  pacingReset();
+  PHASE_RESET();
   Serial.println(F("\n=== Prim MST Algorithm ==="));
 
   // 초기화
   for (int i = 0; i < nodeCount; i++) {
     inMST[i] = false;
-    key[i] = INF;
     parent[i] = -1;
+    heapPos[i] = -1;
   }
+  heapSize = 0;
 
   // 시작 노드 (0번)
   key[0] = 0;
+  heapPushOrDecrease(0);
   int totalWeight = 0;
 
   Serial.println(F("Starting from node 0"));
@@ -451,15 +935,7 @@ void primMST() {
   // n-1개의 간선을 선택
   for (int count = 0; count < nodeCount; count++) {
     // 1. MST에 포함되지 않은 노드 중 key 값이 최소인 노드 찾기
-    int minKey = INF;
-    int u = -1;
-
-    for (int v = 0; v < nodeCount; v++) {
-      if (!inMST[v] && key[v] < minKey) {
-        minKey = key[v];
-        u = v;
-      }
-    }
+    int u = extractMinKeyNode();
 
     if (u == -1)
       break;
@@ -477,81 +953,24 @@ void primMST() {
       Serial.print(F("-"));
       Serial.print(u);
       Serial.print(F(" weight: "));
-      Serial.print(adjMatrix[parent[u]][u]);
+      Serial.print(key[u]);
       Serial.println(F(")"));
 
-      mstEdges[mstCount].u = parent[u];
-      mstEdges[mstCount].v = u;
-      mstEdges[mstCount].weight = adjMatrix[parent[u]][u];
-      mstCount++;
-      totalWeight += adjMatrix[parent[u]][u];
+      mstEdges.set(mstCount++, parent[u], u, key[u]);
+      totalWeight += key[u];
     } else {
       Serial.println(F(" (starting node)"));
     }
 
     // 시각화: MST에 추가된 모습
-    clearDisplay();
-    drawGraph();
-
-    // MST 간선 표시 (초록색)
-    for (int i = 0; i < mstCount; i++) {
-      drawEdge(mstEdges[i].u, mstEdges[i].v, 2);
-    }
-
-    // MST 노드 표시 (초록색)
-    for (int i = 0; i < nodeCount; i++) {
-      if (inMST[i]) {
-        drawNode(i, 0);
-      }
-    }
-
-    // 현재 추가된 노드 (빨강)
-    drawNode(u, 2);
-
-    showDisplay();
+    drawPrimAdded(u);
     hardwareDelay(1000);
 
     // 3. 인접 노드의 key 값 업데이트
-    for (int v = 0; v < nodeCount; v++) {
-      if (adjMatrix[u][v] != INF && !inMST[v] && adjMatrix[u][v] < key[v]) {
-        parent[v] = u;
-        key[v] = adjMatrix[u][v];
-
-        Serial.print(F("  Update key["));
-        Serial.print(v);
-        Serial.print(F("] = "));
-        Serial.println(key[v]);
-      }
-    }
+    relaxNeighbors(u);
 
     // 업데이트된 경계 노드 표시
-    clearDisplay();
-    drawGraph();
-
-    // MST 간선
-    for (int i = 0; i < mstCount; i++) {
-      drawEdge(mstEdges[i].u, mstEdges[i].v, 2);
-    }
-
-    // MST 노드
-    for (int i = 0; i < nodeCount; i++) {
-      if (inMST[i]) {
-        drawNode(i, 0);
-      }
-    }
-
-    // 경계 노드 (key < INF인 미방문 노드) - 노란색
-    for (int v = 0; v < nodeCount; v++) {
-      if (!inMST[v] && key[v] < INF) {
-        drawNode(v, 3);
-        // 경계 간선도 노란색으로
-        if (parent[v] != -1) {
-          drawEdge(parent[v], v, 1);
-        }
-      }
-    }
-
-    showDisplay();
+    drawPrimFrontier();
     hardwareDelay(800);
   }
 
@@ -561,20 +980,142 @@ void primMST() {
   Serial.println(totalWeight);
   Serial.print(F("Edges in MST: "));
   Serial.println(mstCount);
+  serialPrintPacingStats();
+  PHASE_REPORT();
+#ifdef TARGET_PC
+  strip.printTransferStats();
+#endif
 
   clearDisplay();
   drawGraph();
   for (int i = 0; i < mstCount; i++) {
-    drawEdge(mstEdges[i].u, mstEdges[i].v, 2);
-    drawNode(mstEdges[i].u, 0);
-    drawNode(mstEdges[i].v, 0);
+    drawEdge(mstEdges.u[i], mstEdges.v[i], 2);
+    drawNode(mstEdges.u[i], 0);
+    drawNode(mstEdges.v[i], 0);
+  }
+  showDisplay();
+  hardwareDelay(3000);
+}
+
+// ============================================================================
+// 7. 단일 연결 k-클러스터링
+// ============================================================================
+// primMST()가 만든 mstEdges[]에서 가장 무거운 간선 k-1개를 끊으면 남은 트리
+// 조각이 클러스터 (Kruskal을 n-k번 합친 뒤 멈춘 것과 같음). 클러스터마다 다른 색
+
+#define CLUSTER_K 3 // setup()에서 MST 다음에 보여줄 클러스터 수 (0이면 생략)
+#define CLUSTER_COLORS 6
+
+const uint8_t clusterPalette[CLUSTER_COLORS][3] = {
+    {255, 0, 0}, {0, 255, 0}, {0, 80, 255}, {255, 200, 0}, {255, 0, 255}, {0, 255, 255}};
+
+int clusterOf[MAX_NODES]; // 노드별 클러스터 번호
+bool mstCut[MAX_NODES];   // mstEdges[] 중 끊은 간선
+
+// 실제 클러스터 수 반환 (MST가 숲이면 k보다 많을 수 있음)
+int primClusters(int k) {
+  PHASE_SCOPE(PHASE_ALGO);
+  for (int i = 0; i < mstCount; i++) {
+    mstCut[i] = false;
+  }
+  // 같은 가중치면 나중에 들어온 간선부터 끊음
+  for (int c = 0; c < k - 1 && c < mstCount; c++) {
+    int heaviest = -1;
+    for (int i = 0; i < mstCount; i++) {
+      if (!mstCut[i] &&
+          (heaviest < 0 || mstEdges.w[i] >= mstEdges.w[heaviest]))
+        heaviest = i;
+    }
+    mstCut[heaviest] = true;
+  }
+
+  // 끊지 않은 트리 간선만 따라 반복 DFS로 번호 매김
+  for (int v = 0; v < nodeCount; v++) {
+    clusterOf[v] = -1;
+  }
+  int stack[MAX_NODES];
+  int clusters = 0;
+  for (int s = 0; s < nodeCount; s++) {
+    if (clusterOf[s] >= 0)
+      continue;
+    int top = 0;
+    clusterOf[s] = clusters;
+    stack[top++] = s;
+    while (top > 0) {
+      int x = stack[--top];
+      for (int i = 0; i < mstCount; i++) {
+        if (mstCut[i])
+          continue;
+        int y = mstEdges.u[i] == x ? mstEdges.v[i]
+                                   : (mstEdges.v[i] == x ? mstEdges.u[i] : -1);
+        if (y < 0 || clusterOf[y] >= 0)
+          continue;
+        clusterOf[y] = clusters;
+        stack[top++] = y;
+      }
+    }
+    clusters++;
+  }
+  return clusters;
+}
+
+// 클러스터 안 MST 간선은 클러스터 색(어둡게), 노드는 클러스터 색, 나머지는 흐리게
+void drawClusters() {
+  PHASE_SCOPE(PHASE_RENDER);
+  clearDisplay();
+  for (int i = 0; i < edgeCount; i++) {
+    drawEdge(edges.u[i], edges.v[i], 4);
+  }
+  for (int i = 0; i < mstCount; i++) {
+    if (mstCut[i])
+      continue;
+    const int a = mstEdges.u[i], b = mstEdges.v[i];
+    const uint8_t *c = clusterPalette[clusterOf[a] % CLUSTER_COLORS];
+    drawLine(nodes[a].x, nodes[a].y, nodes[b].x, nodes[b].y, c[0] / 4,
+             c[1] / 4, c[2] / 4);
+  }
+  for (int v = 0; v < nodeCount; v++) {
+    const uint8_t *c = clusterPalette[clusterOf[v] % CLUSTER_COLORS];
+    setPixel(nodes[v].x, nodes[v].y, c[0], c[1], c[2]);
   }
   showDisplay();
+}
+
+void showClusters(int k) {
+  if (k < 1 || k > nodeCount)
+    return;
+  Serial.print(F("\n=== Single-linkage clustering (k="));
+  Serial.print(k);
+  Serial.println(F(") ==="));
+  int clusters = primClusters(k);
+  for (int c = 0; c < clusters; c++) {
+    Serial.print(F("  Cluster "));
+    Serial.print(c);
+    Serial.print(F(":"));
+    for (int v = 0; v < nodeCount; v++) {
+      if (clusterOf[v] == c) {
+        Serial.print(F(" "));
+        Serial.print(v);
+      }
+    }
+    Serial.println();
+  }
+  for (int i = 0; i < mstCount; i++) {
+    if (!mstCut[i])
+      continue;
+    Serial.print(F("  Cut "));
+    Serial.print(mstEdges.u[i]);
+    Serial.print(F("-"));
+    Serial.print(mstEdges.v[i]);
+    Serial.print(F(" weight: "));
+    Serial.println(mstEdges.w[i]);
+  }
+  drawClusters();
   hardwareDelay(3000);
 }
 
 // ============================================================================
-// 7. Setup & Loop
+// 8. Setup & Loop
 // ============================================================================
 
 void setup() {
@@ -598,15 +1139,167 @@ void setup() {
   initializeGraph();
   hardwareDelay(1000);
   primMST();
+  if (CLUSTER_K > 0)
+    showClusters(CLUSTER_K);
 }
 
 void loop() {
-  // 알고리즘 완료 후 대기
-  hardwareDelay(1000);
+  // 알고리즘 완료 후 대기 (프레임이 아니므로 페이싱 밖)
+  delay(1000);
 }
 
+// ============================================================================
+// 9. 헤드리스 모드 (PC 전용): ./graph_prim --graph FILE [--clusters K [--labels OUT] | --heatmap]
+// ============================================================================
+// DIMACS / SNAP / 바이너리 그래프를 읽어 시각화 없이 MST만 계산
+// --clusters K: MST에서 가장 무거운 간선 k-1개를 끊어 클러스터 라벨 (OUT: 줄마다 하나)
+// --heatmap: 큰 그래프의 진행을 16x16 칸별 밀도로 애니메이션 (graph_heatmap.h)
+//   칸 밝기 = 트리에 들어간 정점 / 칸의 정점 수, 바뀐 칸만 다시 칠함
+// ./graph_prim --emst [POINTS]: 좌표("x y" 줄)로 유클리드 MST, 파일 없으면 데모 좌표
+
 #ifdef TARGET_PC
-int main() {
+static double headlessMs() {
+  using namespace std::chrono;
+  return duration_cast<duration<double, std::milli>>(
+             steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// k > 0이면 MST를 k개 클러스터로 나눔
+int runHeadless(const char *path, uint32_t k, const char *labelsPath) {
+  EdgeList graph;
+  double t0 = headlessMs();
+  if (!loadGraph(path, graph))
+    return 1;
+  double t1 = headlessMs();
+  std::printf("GRAPH: nodes=%u edges=%zu load_ms=%.1f\n", graph.nodeCount,
+              graph.size(), t1 - t0);
+
+  MstResult result;
+  CsrGraph csr;
+  buildCsr(graph, csr);
+  double csrMs = headlessMs() - t1;
+  t1 = headlessMs();
+  primMST(csr, result);
+  double mstMs = headlessMs() - t1;
+  std::printf("CSR: slots=%zu build_ms=%.1f\n", csr.targets.size(), csrMs);
+  std::printf("MST: algo=prim tree_edges=%zu weight=%lld components=%u "
+              "examined=%llu mst_ms=%.1f\n",
+              result.edgeIds.size(), (long long)result.weight,
+              result.components, (unsigned long long)result.examined, mstMs);
+  if (k == 0)
+    return 0;
+
+  t1 = headlessMs();
+  ClusterResult clusters;
+  forestClusters(graph, result.edgeIds, k, clusters);
+  uint32_t largest = 0;
+  for (uint32_t c = 0; c < clusters.clusters(); c++) {
+    if (clusters.sizes[c] > largest)
+      largest = clusters.sizes[c];
+  }
+  std::printf("CLUSTERS: k=%u clusters=%u cut_edges=%u largest=%u "
+              "cluster_ms=%.1f",
+              k, clusters.clusters(), clusters.cutEdges, largest,
+              headlessMs() - t1);
+  if (clusters.spacingEdge != CLUSTER_NONE)
+    std::printf(" spacing=%d", graph.w[clusters.spacingEdge]);
+  std::printf("\n");
+  return !labelsPath || writeClusterLabels(labelsPath, clusters) ? 0 : 1;
+}
+
+// --heatmap: 정점이 V/HEAT_FRAMES개 트리에 들어갈 때마다 바뀐 칸만 칠하고 프레임 출력
+struct HeatmapFrames {
+  LedHeatmap &heat;
+  uint32_t stride;
+  uint32_t untilFrame;
+
+  void onAddNode(uint32_t u, uint32_t) {
+    heat.addNode(u);
+    if (--untilFrame == 0) {
+      untilFrame = stride;
+      heat.flush(setPixel);
+      showDisplay();
+    }
+  }
+  void onUpdateKey(uint32_t, int32_t, uint32_t) {}
+};
+
+int runHeatmap(const char *path) {
+  EdgeList graph;
+  double t0 = headlessMs();
+  if (!loadGraph(path, graph))
+    return 1;
+  double t1 = headlessMs();
+  std::printf("GRAPH: nodes=%u edges=%zu load_ms=%.1f\n", graph.nodeCount,
+              graph.size(), t1 - t0);
+  LedLayout layout;
+  uint32_t iterations = heatmapLayout(graph, layout);
+  std::printf("LAYOUT: iterations=%u layout_ms=%.1f\n", iterations,
+              headlessMs() - t1);
+
+  LedHeatmap heat(LED_WIDTH, LED_HEIGHT);
+  heat.bind(layout.x, layout.y, false);
+  clearDisplay();
+  heat.flush(setPixel); // 첫 프레임: 노드가 있는 칸 (그래프 윤곽)
+  showDisplay();
+
+  CsrGraph csr;
+  buildCsr(graph, csr);
+  const uint32_t n = graph.nodeCount;
+  const uint32_t stride = n > HEAT_FRAMES ? n / HEAT_FRAMES : 1;
+  HeatmapFrames frames{heat, stride, stride};
+  MstResult result;
+  t1 = headlessMs();
+  primMST(csr, result, frames);
+  if (heat.pending()) {
+    heat.flush(setPixel);
+    showDisplay();
+  }
+  double ms = headlessMs() - t1;
+
+  const HeatStats &st = heat.stats();
+  std::printf("MST: algo=prim tree_edges=%zu weight=%lld components=%u "
+              "mst_ms=%.1f\n",
+              result.edgeIds.size(), (long long)result.weight,
+              result.components, ms);
+  std::printf("HEATMAP: cells=%u occupied=%u frames=%u events=%llu "
+              "repaints=%llu repaints_per_frame=%.1f\n",
+              LED_COUNT, st.occupied, st.frames,
+              (unsigned long long)st.events, (unsigned long long)st.repaints,
+              st.frames ? (double)st.repaints / st.frames : 0.0);
+  return 0;
+}
+
+// --emst [POINTS]: 좌표로 유클리드 MST 계산
+// 파일을 주지 않으면 nodes[] 좌표를 쓰고, edges[] 가중치 표도 좌표와 대조
+int runEmst(const char *path) {
+  PointSet pts;
+  if (path)
+    return loadPoints(path, pts) ? printEuclideanMST(pts, false) : 1;
+  for (int i = 0; i < nodeCount; i++)
+    pts.add(nodes[i].x, nodes[i].y);
+  // 가중치 표가 좌표와 어긋나면 실패로 끝냄 (EMST 자체는 그래도 출력)
+  int mismatches = checkWeightTable(nodes, nodeCount, edges, edgeCount);
+  int rc = printEuclideanMST(pts, true);
+  return mismatches > 0 ? 1 : rc;
+}
+
+int main(int argc, char **argv) {
+  if (argc >= 2 && std::strcmp(argv[1], "--emst") == 0)
+    return runEmst(argc >= 3 ? argv[2] : nullptr);
+  if (argc >= 3 && std::strcmp(argv[1], "--graph") == 0) {
+    if (argc >= 4 && std::strcmp(argv[3], "--heatmap") == 0)
+      return runHeatmap(argv[2]);
+    uint32_t k = 0;
+    const char *labelsPath = nullptr;
+    if (argc >= 5 && std::strcmp(argv[3], "--clusters") == 0) {
+      k = (uint32_t)std::atoi(argv[4]);
+      if (argc >= 7 && std::strcmp(argv[5], "--labels") == 0)
+        labelsPath = argv[6];
+    }
+    return runHeadless(argv[2], k, labelsPath);
+  }
   setup();
   for (int i = 0; i < 3; i++) {
     loop();
@@ -0,0 +1,638 @@
+// 헤드리스 MST 엔진 - PC 전용
+// graph_kruskal.cpp / graph_prim.cpp의 --graph 모드와 graph_bench.cpp에서 사용
+// 시각화 없이 수백만 정점 그래프에서 같은 알고리즘을 돌림
+// 결과 간선은 입력 EdgeList의 인덱스 (선택된 순서)
+// 6절: MST로 단일 연결(single-linkage) k-클러스터링
+
+#ifndef MST_ENGINES_H
+#define MST_ENGINES_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "disjoint_set.h"
+#include "graph_csr.h"
+#include "graph_edges.h"
+
+// ============================================================================
+// 1. 결과
+// ============================================================================
+
+struct MstResult {
+  std::vector<uint32_t> edgeIds; // 트리 간선 (선택 순서)
+  int64_t weight = 0;
+  uint32_t components = 0;       // 연결 요소 수 (1이면 신장 트리)
+  uint64_t examined = 0;         // 검사한 간선(또는 인접 슬롯) 수
+  uint32_t rounds = 0;           // Borůvka 라운드 수
+
+  void reset() {
+    edgeIds.clear();
+    weight = 0;
+    components = 0;
+    examined = 0;
+    rounds = 0;
+  }
+};
+
+// ============================================================================
+// 2. Kruskal
+// ============================================================================
+// 입력은 그대로 두고 정렬 순열만 만듦 (간선 인덱스가 파일 순서와 일치)
+
+// 시각화/기록용 이벤트 (graph_kruskal.cpp의 --heatmap): 트리에 들어간 간선, 선택 순서
+struct KruskalNoEvents {
+  void onAccept(uint32_t) {}
+};
+
+// components > 1이면 집합이 그 수만큼 남았을 때 멈춤 (n - components번 합침)
+template <typename Listener>
+void kruskalMST(const EdgeList &edges, MstResult &out, Listener &events,
+                uint32_t components = 1) {
+  out.reset();
+  const uint32_t n = edges.nodeCount;
+  std::vector<uint32_t> keys(edges.size());
+  for (size_t i = 0; i < keys.size(); i++)
+    keys[i] = weightKey(edges.w[i]);
+  std::vector<uint32_t> order = radixSortPermutation(std::move(keys));
+
+  DisjointSet<uint32_t> sets(n);
+  out.edgeIds.reserve(n ? n - 1 : 0);
+  for (size_t k = 0; k < order.size() && out.edgeIds.size() + components < n;
+       k++) {
+    uint32_t i = order[k];
+    out.examined++;
+    if (sets.unite(edges.u[i], edges.v[i])) {
+      out.edgeIds.push_back(i);
+      out.weight += edges.w[i];
+      events.onAccept(i);
+    }
+  }
+  out.components = n - (uint32_t)out.edgeIds.size();
+}
+
+inline void kruskalMST(const EdgeList &edges, MstResult &out,
+                       uint32_t components = 1) {
+  KruskalNoEvents none;
+  kruskalMST(edges, out, none, components);
+}
+
+// 지연 정렬 Kruskal: 전부 정렬하지 않고 IncrementalSorter로 필요한 만큼만 꺼냄
+// V-1개가 합쳐지면 바로 끝나므로, 밀집 그래프에서 무거운 간선 대부분은
+// 분할 덩어리로 남은 채 비교되지 않음. 미검사 간선 수 = edges.size() - examined
+inline void lazyKruskalMST(const EdgeList &edges, MstResult &out) {
+  out.reset();
+  const uint32_t n = edges.nodeCount;
+  const size_t m = edges.size();
+  std::vector<KeyedIndex<uint32_t>> items(m);
+  for (size_t i = 0; i < m; i++) {
+    items[i].key = weightKey(edges.w[i]);
+    items[i].index = (uint32_t)i;
+  }
+  IncrementalSorter<KeyedIndex<uint32_t>> sorter(items.data(), m);
+
+  DisjointSet<uint32_t> sets(n);
+  out.edgeIds.reserve(n ? n - 1 : 0);
+  while (!sorter.done() && out.edgeIds.size() + 1 < n) {
+    uint32_t i = sorter.next().index;
+    out.examined++;
+    if (sets.unite(edges.u[i], edges.v[i])) {
+      out.edgeIds.push_back(i);
+      out.weight += edges.w[i];
+    }
+  }
+  out.components = n - (uint32_t)out.edgeIds.size();
+}
+
+// ============================================================================
+// 3. Filter-Kruskal (병렬 분할)
+// ============================================================================
+// 피벗 이하(가벼운) 간선을 먼저 재귀 처리한 뒤, 무거운 간선 중 두 끝점이 이미
+// 연결된 것을 걸러내고 나머지로 재귀. 작은 구간은 정렬 후 일반 Kruskal
+// 분할/필터는 청크별 개수 세기 -> 누적합 -> 흩뿌리기로 병렬화 (순서 유지)
+// 같은 가중치 간선의 선택은 달라질 수 있지만 MST 가중치는 kruskalMST()와 같음
+
+#define FILTER_KRUSKAL_BASE 4096      // 이하이면 정렬 후 일반 Kruskal
+#define FILTER_KRUSKAL_PAR_MIN 65536  // 이하이면 분할을 단일 스레드로
+#define FILTER_KRUSKAL_SAMPLES 63     // 피벗 후보 표본 수
+
+// [begin, end) 청크마다 body(t, begin, end) 실행
+template <typename Body>
+void parallelChunks(size_t n, unsigned threads, const Body &body) {
+  if (threads <= 1 || n < FILTER_KRUSKAL_PAR_MIN) {
+    body(0, 0, n);
+    return;
+  }
+  std::vector<std::thread> pool;
+  size_t chunk = (n + threads - 1) / threads;
+  for (unsigned t = 0; t < threads; t++) {
+    size_t begin = t * chunk;
+    size_t end = begin + chunk < n ? begin + chunk : n;
+    if (begin >= end)
+      break;
+    pool.emplace_back([&body, t, begin, end]() { body(t, begin, end); });
+  }
+  for (size_t t = 0; t < pool.size(); t++)
+    pool[t].join();
+}
+
+// 분할 대상: (정렬 키, 간선 인덱스). 키를 같이 들고 다녀 분할이 순차 접근이 됨
+typedef KeyedIndex<uint32_t> KeyedEdge;
+
+// classify(item): 0 -> 앞쪽, 1 -> 뒤쪽, 2 -> 버림. in -> out 안정 분할
+// 반환: (앞쪽 개수, 뒤쪽 개수)
+template <typename Classify>
+std::pair<size_t, size_t> parallelSplit(const KeyedEdge *in, size_t n,
+                                        KeyedEdge *out, unsigned threads,
+                                        const Classify &classify) {
+  std::vector<size_t> counts((size_t)threads * 2, 0);
+  parallelChunks(n, threads, [&](unsigned t, size_t begin, size_t end) {
+    size_t c[3] = {0, 0, 0};
+    for (size_t i = begin; i < end; i++)
+      c[classify(in[i])]++;
+    counts[t * 2] = c[0];
+    counts[t * 2 + 1] = c[1];
+  });
+
+  size_t front = 0, back = 0;
+  for (unsigned t = 0; t < threads; t++) {
+    front += counts[t * 2];
+    back += counts[t * 2 + 1];
+  }
+  // 청크별 시작 위치로 변환
+  size_t frontPos = 0, backPos = front;
+  for (unsigned t = 0; t < threads; t++) {
+    size_t f = counts[t * 2], b = counts[t * 2 + 1];
+    counts[t * 2] = frontPos;
+    counts[t * 2 + 1] = backPos;
+    frontPos += f;
+    backPos += b;
+  }
+
+  parallelChunks(n, threads, [&](unsigned t, size_t begin, size_t end) {
+    size_t f = counts[t * 2], b = counts[t * 2 + 1];
+    for (size_t i = begin; i < end; i++) {
+      int c = classify(in[i]);
+      if (c == 0)
+        out[f++] = in[i];
+      else if (c == 1)
+        out[b++] = in[i];
+    }
+  });
+  return std::make_pair(front, back);
+}
+
+struct FilterKruskal {
+  const EdgeList &edges;
+  ConcurrentDisjointSet<uint32_t> sets;
+  MstResult &out;
+  unsigned threads;
+
+  FilterKruskal(const EdgeList &e, MstResult &r, unsigned t)
+      : edges(e), sets(e.nodeCount), out(r), threads(t ? t : 1) {}
+
+  bool done() const { return out.edgeIds.size() + 1 >= edges.nodeCount; }
+
+  void kruskalBase(KeyedEdge *items, size_t n) {
+    introSort(items, n);
+    for (size_t i = 0; i < n && !done(); i++) {
+      uint32_t id = items[i].index;
+      out.examined++;
+      if (sets.unite(edges.u[id], edges.v[id])) {
+        out.edgeIds.push_back(id);
+        out.weight += edges.w[id];
+      }
+    }
+  }
+
+  static uint32_t pickPivot(const KeyedEdge *items, size_t n) {
+    uint32_t sample[FILTER_KRUSKAL_SAMPLES];
+    for (int i = 0; i < FILTER_KRUSKAL_SAMPLES; i++)
+      sample[i] = items[(n - 1) * i / (FILTER_KRUSKAL_SAMPLES - 1)].key;
+    insertionSortRange(sample, 0, FILTER_KRUSKAL_SAMPLES);
+    return sample[FILTER_KRUSKAL_SAMPLES / 2];
+  }
+
+  // items[0, n)을 처리. scratch는 같은 길이의 작업 버퍼 (재귀마다 역할 교대)
+  void run(KeyedEdge *items, KeyedEdge *scratch, size_t n) {
+    if (n == 0 || done())
+      return;
+    if (n <= FILTER_KRUSKAL_BASE) {
+      kruskalBase(items, n);
+      return;
+    }
+
+    const uint32_t pivot = pickPivot(items, n);
+    std::pair<size_t, size_t> split =
+        parallelSplit(items, n, scratch, threads, [pivot](const KeyedEdge &e) {
+          return e.key <= pivot ? 0 : 1;
+        });
+    if (split.second == 0) { // 피벗이 최댓값 (동점이 많은 경우)
+      kruskalBase(items, n);
+      return;
+    }
+
+    run(scratch, items, split.first);
+    if (done())
+      return;
+
+    // 무거운 쪽 필터: 스레드마다 find()로 경로를 줄이며 검사 (CAS라 동시 호출 안전)
+    KeyedEdge *heavy = scratch + split.first;
+    KeyedEdge *kept = items + split.first;
+    size_t keptCount =
+        parallelSplit(heavy, split.second, kept, threads,
+                      [this](const KeyedEdge &e) {
+                        return sets.find(edges.u[e.index]) ==
+                                       sets.find(edges.v[e.index])
+                                   ? 2
+                                   : 0;
+                      })
+            .first;
+    out.examined += split.second - keptCount;
+    run(kept, heavy, keptCount);
+  }
+};
+
+// threads가 0이면 하드웨어 스레드 수 사용
+inline void filterKruskalMST(const EdgeList &edges, MstResult &out,
+                             unsigned threads = 0) {
+  out.reset();
+  if (threads == 0)
+    threads = std::thread::hardware_concurrency();
+  const size_t m = edges.size();
+  std::vector<KeyedEdge> items(m), scratch(m);
+  for (size_t i = 0; i < m; i++) {
+    items[i].key = weightKey(edges.w[i]);
+    items[i].index = (uint32_t)i;
+  }
+  out.edgeIds.reserve(edges.nodeCount ? edges.nodeCount - 1 : 0);
+
+  FilterKruskal engine(edges, out, threads);
+  engine.run(items.data(), scratch.data(), m);
+  out.components = edges.nodeCount - (uint32_t)out.edgeIds.size();
+}
+
+// ============================================================================
+// 4. Borůvka (병렬)
+// ============================================================================
+// 라운드마다: 1) 컴포넌트별 최소 간선 (원자적 최솟값) 2) 그 간선으로 연결
+// 3) 포인터 점프로 컴포넌트 축약 4) 같은 컴포넌트 안의 간선 제거
+// 간선 순서는 (가중치, 간선 인덱스)의 전순서라서 서로를 고른 두 컴포넌트는
+// 반드시 같은 간선을 고름 -> 번호가 작은 쪽을 대표로 두면 사이클이 없음
+
+#define BORUVKA_NONE UINT64_MAX
+
+inline uint64_t boruvkaRank(const KeyedEdge &e) {
+  return ((uint64_t)e.key << 32) | e.index;
+}
+
+inline void atomicMin(std::atomic<uint64_t> &slot, uint64_t value) {
+  uint64_t cur = slot.load(std::memory_order_relaxed);
+  while (value < cur &&
+         !slot.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {
+  }
+}
+
+// threads가 0이면 하드웨어 스레드 수 사용
+inline void boruvkaMST(const EdgeList &edges, MstResult &out,
+                       unsigned threads = 0) {
+  out.reset();
+  if (threads == 0)
+    threads = std::thread::hardware_concurrency();
+  if (threads == 0)
+    threads = 1;
+  const uint32_t n = edges.nodeCount;
+  const size_t m = edges.size();
+
+  // label[v]: v가 속한 컴포넌트 대표 (대표는 label[c] == c)
+  std::vector<uint32_t> label(n), link(n), jump(n);
+  std::unique_ptr<std::atomic<uint64_t>[]> best(new std::atomic<uint64_t>[n]);
+  for (uint32_t v = 0; v < n; v++)
+    label[v] = v;
+
+  std::vector<KeyedEdge> active(m), scratch(m);
+  for (size_t i = 0; i < m; i++) {
+    active[i].key = weightKey(edges.w[i]);
+    active[i].index = (uint32_t)i;
+  }
+  // 자기 루프 제거
+  size_t activeCount =
+      parallelSplit(active.data(), m, scratch.data(), threads,
+                    [&](const KeyedEdge &e) {
+                      return edges.u[e.index] == edges.v[e.index] ? 2 : 0;
+                    })
+          .first;
+  active.swap(scratch);
+  out.edgeIds.reserve(n ? n - 1 : 0);
+
+  while (activeCount > 0 && out.edgeIds.size() + 1 < n) {
+    out.rounds++;
+    out.examined += activeCount;
+
+    // 1) 컴포넌트별 최소 간선
+    parallelChunks(n, threads, [&](unsigned, size_t begin, size_t end) {
+      for (size_t c = begin; c < end; c++)
+        best[c].store(BORUVKA_NONE, std::memory_order_relaxed);
+    });
+    parallelChunks(activeCount, threads,
+                   [&](unsigned, size_t begin, size_t end) {
+                     for (size_t i = begin; i < end; i++) {
+                       const KeyedEdge &e = active[i];
+                       uint64_t rank = boruvkaRank(e);
+                       atomicMin(best[label[edges.u[e.index]]], rank);
+                       atomicMin(best[label[edges.v[e.index]]], rank);
+                     }
+                   });
+
+    // 2) 최소 간선의 반대편 컴포넌트를 가리킴
+    parallelChunks(n, threads, [&](unsigned, size_t begin, size_t end) {
+      for (size_t c = begin; c < end; c++) {
+        uint64_t b = best[c].load(std::memory_order_relaxed);
+        if (label[c] != c || b == BORUVKA_NONE) {
+          link[c] = (uint32_t)c;
+          continue;
+        }
+        uint32_t id = (uint32_t)b;
+        uint32_t cu = label[edges.u[id]];
+        link[c] = cu == c ? label[edges.v[id]] : cu;
+      }
+    });
+    // 서로를 가리키는 쌍은 번호가 작은 쪽이 대표 (간선은 큰 쪽이 추가)
+    parallelChunks(n, threads, [&](unsigned, size_t begin, size_t end) {
+      for (size_t c = begin; c < end; c++) {
+        uint32_t d = link[c];
+        jump[c] = (d != c && link[d] == c && c < d) ? (uint32_t)c : d;
+      }
+    });
+    for (uint32_t c = 0; c < n; c++) {
+      if (jump[c] != c) {
+        uint32_t id = (uint32_t)best[c].load(std::memory_order_relaxed);
+        out.edgeIds.push_back(id);
+        out.weight += edges.w[id];
+      }
+    }
+
+    // 3) 포인터 점프: 모든 컴포넌트가 별(star)의 중심을 가리킬 때까지
+    link.swap(jump);
+    bool changed = true;
+    while (changed) {
+      std::atomic<bool> anyChange(false);
+      parallelChunks(n, threads, [&](unsigned, size_t begin, size_t end) {
+        bool local = false;
+        for (size_t c = begin; c < end; c++) {
+          jump[c] = link[link[c]];
+          local |= jump[c] != link[c];
+        }
+        if (local)
+          anyChange.store(true, std::memory_order_relaxed);
+      });
+      link.swap(jump);
+      changed = anyChange.load();
+    }
+    parallelChunks(n, threads, [&](unsigned, size_t begin, size_t end) {
+      for (size_t v = begin; v < end; v++)
+        label[v] = link[label[v]];
+    });
+
+    // 4) 같은 컴포넌트 안쪽이 된 간선 제거
+    activeCount = parallelSplit(active.data(), activeCount, scratch.data(),
+                                threads, [&](const KeyedEdge &e) {
+                                  return label[edges.u[e.index]] ==
+                                                 label[edges.v[e.index]]
+                                             ? 2
+                                             : 0;
+                                })
+                      .first;
+    active.swap(scratch);
+  }
+  out.components = n - (uint32_t)out.edgeIds.size();
+}
+
+// ============================================================================
+// 5. Prim (CSR + 인덱스 d-ary 힙, decrease-key)
+// ============================================================================
+// 정점마다 힙 안의 위치를 기억해 key를 제자리에서 줄임 (지연 삭제 없음)
+// 순서: key, 같으면 정점 번호 -> graph_prim.cpp의 시각화와 같은 선택 순서
+// 연결되지 않은 그래프는 방문하지 않은 정점마다 다시 시작 (최소 신장 숲)
+
+#define HEAP_NONE UINT32_MAX
+
+template <unsigned D, typename Key> class IndexedDaryHeap {
+public:
+  explicit IndexedDaryHeap(uint32_t n) : pos_(n, HEAP_NONE), key_(n) {}
+
+  bool empty() const { return heap_.empty(); }
+  bool contains(uint32_t v) const { return pos_[v] != HEAP_NONE; }
+  Key key(uint32_t v) const { return key_[v]; }
+
+  // 힙에 없으면 추가, 있으면 k가 더 작을 때만 줄임. 바뀌었으면 true
+  bool pushOrDecrease(uint32_t v, Key k) {
+    if (pos_[v] == HEAP_NONE) {
+      pos_[v] = (uint32_t)heap_.size();
+      heap_.push_back(v);
+    } else if (!(k < key_[v])) {
+      return false;
+    }
+    key_[v] = k;
+    siftUp(pos_[v]);
+    return true;
+  }
+
+  uint32_t popMin() {
+    uint32_t top = heap_[0];
+    pos_[top] = HEAP_NONE;
+    uint32_t last = heap_.back();
+    heap_.pop_back();
+    if (!heap_.empty()) {
+      place(0, last);
+      siftDown(0);
+    }
+    return top;
+  }
+
+private:
+  bool less(uint32_t a, uint32_t b) const {
+    return key_[a] < key_[b] || (!(key_[b] < key_[a]) && a < b);
+  }
+
+  void place(size_t i, uint32_t v) {
+    heap_[i] = v;
+    pos_[v] = (uint32_t)i;
+  }
+
+  void siftUp(size_t i) {
+    uint32_t v = heap_[i];
+    while (i > 0) {
+      size_t p = (i - 1) / D;
+      if (!less(v, heap_[p]))
+        break;
+      place(i, heap_[p]);
+      i = p;
+    }
+    place(i, v);
+  }
+
+  void siftDown(size_t i) {
+    const size_t n = heap_.size();
+    uint32_t v = heap_[i];
+    while (true) {
+      size_t first = i * D + 1;
+      if (first >= n)
+        break;
+      size_t best = first;
+      size_t end = first + D < n ? first + D : n;
+      for (size_t c = first + 1; c < end; c++) {
+        if (less(heap_[c], heap_[best]))
+          best = c;
+      }
+      if (!less(heap_[best], v))
+        break;
+      place(i, heap_[best]);
+      i = best;
+    }
+    place(i, v);
+  }
+
+  std::vector<uint32_t> heap_;
+  std::vector<uint32_t> pos_;
+  std::vector<Key> key_;
+};
+
+// 시각화/기록용 이벤트 (graph_prim.cpp의 "Adding node" / "Update key")
+// edgeId: 트리에 들어온(또는 key를 준) 간선, 시작 정점은 HEAP_NONE
+struct PrimNoEvents {
+  void onAddNode(uint32_t, uint32_t) {}
+  void onUpdateKey(uint32_t, int32_t, uint32_t) {}
+};
+
+template <unsigned D = 4, typename Listener>
+void primMST(const CsrGraph &g, MstResult &out, Listener &events) {
+  out.reset();
+  const uint32_t n = g.nodeCount;
+  IndexedDaryHeap<D, int32_t> heap(n);
+  std::vector<uint8_t> inTree(n, 0);
+  std::vector<uint32_t> via(n, HEAP_NONE); // key를 준 간선
+  out.edgeIds.reserve(n ? n - 1 : 0);
+
+  for (uint32_t root = 0; root < n; root++) {
+    if (inTree[root])
+      continue;
+    out.components++;
+    heap.pushOrDecrease(root, INT32_MIN);
+
+    while (!heap.empty()) {
+      uint32_t u = heap.popMin();
+      inTree[u] = 1;
+      events.onAddNode(u, via[u]);
+      if (via[u] != HEAP_NONE) {
+        out.edgeIds.push_back(via[u]);
+        out.weight += heap.key(u);
+      }
+      for (uint64_t k = g.begin(u); k < g.end(u); k++) {
+        out.examined++;
+        uint32_t v = g.targets[k];
+        if (!inTree[v] && heap.pushOrDecrease(v, g.weights[k])) {
+          via[v] = g.edgeIds[k];
+          events.onUpdateKey(v, g.weights[k], g.edgeIds[k]);
+        }
+      }
+    }
+  }
+}
+
+template <unsigned D = 4> void primMST(const CsrGraph &g, MstResult &out) {
+  PrimNoEvents none;
+  primMST<D>(g, out, none);
+}
+
+// ============================================================================
+// 6. 단일 연결 k-클러스터링
+// ============================================================================
+// MST에서 가장 무거운 간선 k-1개를 끊은 것 = Kruskal을 n-k번 합친 뒤 멈춘 것
+// 두 방법 모두 클러스터 사이 최소 거리(spacing)가 최대인 분할을 줌
+//   - kruskalClusters: kruskalMST()를 집합 k개에서 멈추고 남은 숲을 라벨링
+//   - forestClusters:  이미 있는 트리(예: primMST 결과)에서 무거운 간선부터 끊음
+// 라벨은 노드 번호 순으로 처음 나온 클러스터부터 0, 1, 2, ...
+// 그래프가 원래 k개보다 많은 조각이면 조각 수만큼 클러스터가 나옴
+
+#define CLUSTER_NONE UINT32_MAX
+
+struct ClusterResult {
+  std::vector<uint32_t> labels;     // 노드별 클러스터 번호
+  std::vector<uint32_t> sizes;      // 클러스터별 노드 수
+  uint32_t cutEdges = 0;            // 트리에서 끊은 간선 수
+  uint32_t spacingEdge = CLUSTER_NONE; // 클러스터 사이 가장 가벼운 간선 (없으면 NONE)
+
+  uint32_t clusters() const { return (uint32_t)sizes.size(); }
+};
+
+// treeIds(숲)에서 무거운 간선부터 끊어 클러스터가 k개 이상이 되게 하고 라벨링
+// 같은 가중치는 treeIds 안에서 뒤쪽 간선을 먼저 끊음
+inline void forestClusters(const EdgeList &edges,
+                           const std::vector<uint32_t> &treeIds, uint32_t k,
+                           ClusterResult &out) {
+  const uint32_t n = edges.nodeCount;
+  const size_t treeCount = treeIds.size();
+  const uint32_t have = n - (uint32_t)treeCount; // 지금 조각 수
+  out.cutEdges = 0;
+  if (k > have)
+    out.cutEdges = k - have < treeCount ? k - have : (uint32_t)treeCount;
+
+  std::vector<uint32_t> keys(treeCount);
+  for (size_t i = 0; i < treeCount; i++)
+    keys[i] = weightKey(edges.w[treeIds[i]]);
+  std::vector<uint32_t> order = radixSortPermutation(std::move(keys));
+  DisjointSet<uint32_t> sets(n);
+  for (size_t j = 0; j + out.cutEdges < treeCount; j++) {
+    const uint32_t id = treeIds[order[j]];
+    sets.unite(edges.u[id], edges.v[id]);
+  }
+
+  out.labels.assign(n, CLUSTER_NONE);
+  out.sizes.clear();
+  std::vector<uint32_t> rootLabel(n, CLUSTER_NONE);
+  for (uint32_t v = 0; v < n; v++) {
+    const uint32_t root = sets.find(v);
+    if (rootLabel[root] == CLUSTER_NONE) {
+      rootLabel[root] = (uint32_t)out.sizes.size();
+      out.sizes.push_back(0);
+    }
+    out.labels[v] = rootLabel[root];
+    out.sizes[out.labels[v]]++;
+  }
+
+  out.spacingEdge = CLUSTER_NONE;
+  for (size_t i = 0; i < edges.size(); i++) {
+    if (out.labels[edges.u[i]] == out.labels[edges.v[i]])
+      continue;
+    if (out.spacingEdge == CLUSTER_NONE || edges.w[i] < edges.w[out.spacingEdge])
+      out.spacingEdge = (uint32_t)i;
+  }
+}
+
+// 한 줄에 노드 하나씩 클러스터 번호
+inline bool writeClusterLabels(const char *path, const ClusterResult &clusters) {
+  FILE *f = std::fopen(path, "w");
+  if (!f) {
+    std::fprintf(stderr, "cannot create %s\n", path);
+    return false;
+  }
+  for (size_t v = 0; v < clusters.labels.size(); v++)
+    std::fprintf(f, "%u\n", clusters.labels[v]);
+  return std::fclose(f) == 0;
+}
+
+inline void kruskalClusters(const EdgeList &edges, uint32_t k,
+                            ClusterResult &out) {
+  MstResult forest;
+  kruskalMST(edges, forest, k ? k : 1);
+  forestClusters(edges, forest.edgeIds, k, out);
+}
+
+#endif
@@ -0,0 +1,236 @@
+// MST 검증기 - PC 전용
+// 후보 트리(간선 인덱스 목록)가 그래프의 최소 신장 포레스트인지 확인
+//   1) 신장 포레스트인지: 인덱스 범위, 중복/사이클 없음, 트리 밖 간선이 모두
+//      같은 트리 안을 잇는지 (컴포넌트 수가 그래프와 같음)
+//   2) 사이클 성질: 트리 밖 간선 (u, v, w)마다 트리 경로 u-v의 최대 가중치 <= w
+// 경로 최대값은 오프라인으로: Tarjan 오프라인 LCA와 같은 DFS에서
+// "조상 방향 최대 가중치"를 들고 다니는 경로 압축 Union-Find로 계산
+// 질의마다 LCA를 찾아 그 노드에 걸어 두고, LCA의 서브트리가 끝날 때 나머지 쪽 최대값을 읽음
+// 노드를 DFS 전위 순서로 다시 번호 매겨 본 단계는 배열을 순서대로 훑음 (캐시 지역성)
+// 전체 O((V + E) log V) 이하 (경로 반감만 사용), 재귀 없음
+
+#ifndef MST_VERIFY_H
+#define MST_VERIFY_H
+
+#include <cstdint>
+#include <vector>
+
+#include "disjoint_set.h"
+#include "graph_edges.h"
+
+#define VERIFY_NONE UINT32_MAX
+
+struct MstVerifyResult {
+  bool ok = false;
+  const char *error = nullptr; // 구조 오류 (신장 포레스트가 아님)
+  uint64_t checked = 0;        // 사이클 성질을 확인한 트리 밖 간선 수
+  uint64_t violations = 0;     // 트리 경로 최대값보다 가벼운 트리 밖 간선 수
+  uint32_t firstViolation = VERIFY_NONE; // 그런 간선 하나 (EdgeList 인덱스)
+  int32_t firstPathMax = 0;    // 그 간선 양 끝의 트리 경로 최대 가중치
+  int64_t treeWeight = 0;
+};
+
+// 경로 압축 + 조상까지의 최대 가중치
+class PathMaxForest {
+public:
+  explicit PathMaxForest(uint32_t n) : link_(n), up_(n, INT32_MIN) {
+    for (uint32_t i = 0; i < n; i++)
+      link_[i] = i;
+  }
+
+  // x가 속한 집합의 루트, 그리고 x -> 루트 경로의 최대 가중치 (루트 자신이면 INT32_MIN)
+  // 경로 반감(path halving): x를 할아버지에 붙이면서 up_도 두 칸 최대값으로 합침
+  uint32_t find(uint32_t x, int32_t &pathMax) {
+    int32_t best = INT32_MIN;
+    while (link_[x] != x) {
+      const uint32_t p = link_[x];
+      if (link_[p] != p) {
+        if (up_[p] > up_[x])
+          up_[x] = up_[p];
+        link_[x] = link_[p];
+      }
+      if (up_[x] > best)
+        best = up_[x];
+      x = link_[x];
+    }
+    pathMax = best;
+    return x;
+  }
+
+  // 루트 x를 parent 밑에 weight로 연결
+  void link(uint32_t x, uint32_t parent, int32_t weight) {
+    link_[x] = parent;
+    up_[x] = weight;
+  }
+
+private:
+  std::vector<uint32_t> link_;
+  std::vector<int32_t> up_; // link_[x]까지 올라가는 경로의 최대 가중치
+};
+
+inline MstVerifyResult verifyMst(const EdgeList &edges,
+                                 const std::vector<uint32_t> &treeIds) {
+  MstVerifyResult r;
+  const uint32_t n = edges.nodeCount;
+  const size_t m = edges.size();
+
+  // 1. 포레스트인지 (사이클, 중복, 범위)
+  std::vector<char> inTree(m, 0);
+  DisjointSet<uint32_t> treeSets(n);
+  for (size_t k = 0; k < treeIds.size(); k++) {
+    const uint32_t id = treeIds[k];
+    if (id >= m || inTree[id]) {
+      r.error = "tree edge index out of range or repeated";
+      return r;
+    }
+    inTree[id] = 1;
+    if (!treeSets.unite(edges.u[id], edges.v[id])) {
+      r.error = "tree edges contain a cycle";
+      return r;
+    }
+    r.treeWeight += edges.w[id];
+  }
+
+  // 2. 트리 인접 (CSR) 후 DFS 전위 순서로 번호를 다시 매김
+  //    서브트리 = 연속 구간 [rank, end), 부모 번호와 부모 간선 가중치만 남김
+  std::vector<uint32_t> treeStart((size_t)n + 1, 0);
+  for (size_t k = 0; k < treeIds.size(); k++) {
+    treeStart[edges.u[treeIds[k]] + 1]++;
+    treeStart[edges.v[treeIds[k]] + 1]++;
+  }
+  for (uint32_t v = 0; v < n; v++)
+    treeStart[v + 1] += treeStart[v];
+  struct TreeSlot {
+    uint32_t node;
+    int32_t weight;
+  };
+  std::vector<TreeSlot> treeSlot(treeStart[n]);
+  // 채운 뒤 cursor[x] == treeStart[x + 1], DFS에서는 거꾸로 내려가며 사용
+  std::vector<uint32_t> cursor(treeStart.begin(), treeStart.end() - 1);
+  for (size_t k = 0; k < treeIds.size(); k++) {
+    const uint32_t id = treeIds[k];
+    treeSlot[cursor[edges.u[id]]++] = TreeSlot{edges.v[id], edges.w[id]};
+    treeSlot[cursor[edges.v[id]]++] = TreeSlot{edges.u[id], edges.w[id]};
+  }
+
+  std::vector<uint32_t> rank(n, VERIFY_NONE);
+  std::vector<uint32_t> parent(n), end(n); // 전위 번호 기준
+  std::vector<int32_t> upWeight(n);
+  {
+    std::vector<uint32_t> stack;
+    uint32_t next = 0;
+    for (uint32_t root = 0; root < n; root++) {
+      if (rank[root] != VERIFY_NONE)
+        continue;
+      rank[root] = next;
+      parent[next] = VERIFY_NONE;
+      upWeight[next] = INT32_MIN;
+      next++;
+      stack.push_back(root);
+      while (!stack.empty()) {
+        const uint32_t x = stack.back();
+        if (cursor[x] == treeStart[x]) {
+          end[rank[x]] = next;
+          stack.pop_back();
+          continue;
+        }
+        const TreeSlot &slot = treeSlot[--cursor[x]];
+        if (rank[slot.node] != VERIFY_NONE)
+          continue;
+        rank[slot.node] = next;
+        parent[next] = rank[x];
+        upWeight[next] = slot.weight;
+        next++;
+        stack.push_back(slot.node);
+      }
+    }
+  }
+  std::vector<TreeSlot>().swap(treeSlot);
+  std::vector<uint32_t>().swap(cursor);
+  std::vector<uint32_t>().swap(treeStart);
+
+  // 3. 트리 밖 간선은 번호가 큰 끝점에만 질의로 등록
+  //    (그 끝점에 들어갈 때 다른 끝점은 이미 방문한 상태)
+  std::vector<uint32_t> queryStart((size_t)n + 1, 0);
+  for (size_t i = 0; i < m; i++) {
+    if (inTree[i] || edges.u[i] == edges.v[i])
+      continue; // 자기 루프는 어떤 트리에도 들어가지 않음
+    // 트리 밖 간선의 두 끝이 다른 트리면 포레스트가 신장하지 않음
+    if (treeSets.find(edges.u[i]) != treeSets.find(edges.v[i])) {
+      r.error = "tree is not spanning (non-tree edge joins two trees)";
+      return r;
+    }
+    const uint32_t a = rank[edges.u[i]], b = rank[edges.v[i]];
+    queryStart[(a > b ? a : b) + 1]++;
+  }
+  for (uint32_t v = 0; v < n; v++)
+    queryStart[v + 1] += queryStart[v];
+  std::vector<uint32_t> querySlot(queryStart[n]);
+  {
+    std::vector<uint32_t> fill(queryStart.begin(), queryStart.end() - 1);
+    for (size_t i = 0; i < m; i++) {
+      if (inTree[i] || edges.u[i] == edges.v[i])
+        continue;
+      const uint32_t a = rank[edges.u[i]], b = rank[edges.v[i]];
+      querySlot[fill[a > b ? a : b]++] = (uint32_t)i;
+    }
+  }
+
+  // 4. 전위 순서로 한 번 훑기 = DFS 재현
+  //    x에 들어가기 전에 구간이 끝난 노드들을 빠져나오며 부모 밑에 연결
+  //    질의 (x, y): LCA = y가 속한 집합의 루트 (아직 열려 있는 조상)
+  //    y -> LCA 구간은 이미 연결돼 최대값이 지금 확정, x 쪽은 LCA가 닫힐 때 읽음
+  struct Pending {
+    uint32_t id, from;
+    int32_t otherMax;
+  };
+  PathMaxForest forest(n);
+  std::vector<Pending> atLca;
+  std::vector<uint32_t> lcaHead(n, VERIFY_NONE), lcaNext;
+  std::vector<uint32_t> open;
+
+  auto close = [&](uint32_t x) {
+    for (uint32_t q = lcaHead[x]; q != VERIFY_NONE; q = lcaNext[q]) {
+      int32_t pathMax;
+      forest.find(atLca[q].from, pathMax);
+      if (atLca[q].otherMax > pathMax)
+        pathMax = atLca[q].otherMax;
+      r.checked++;
+      if (edges.w[atLca[q].id] < pathMax) {
+        if (r.violations++ == 0) {
+          r.firstViolation = atLca[q].id;
+          r.firstPathMax = pathMax;
+        }
+      }
+    }
+    if (parent[x] != VERIFY_NONE)
+      forest.link(x, parent[x], upWeight[x]);
+  };
+
+  for (uint32_t x = 0; x < n; x++) {
+    while (!open.empty() && end[open.back()] <= x) {
+      close(open.back());
+      open.pop_back();
+    }
+    for (uint32_t k = queryStart[x]; k < queryStart[x + 1]; k++) {
+      const uint32_t id = querySlot[k];
+      const uint32_t y = rank[edges.u[id]] == x ? rank[edges.v[id]]
+                                                : rank[edges.u[id]];
+      int32_t maxY;
+      const uint32_t lca = forest.find(y, maxY);
+      atLca.push_back(Pending{id, x, maxY});
+      lcaNext.push_back(lcaHead[lca]);
+      lcaHead[lca] = (uint32_t)(atLca.size() - 1);
+    }
+    open.push_back(x);
+  }
+  while (!open.empty()) {
+    close(open.back());
+    open.pop_back();
+  }
+
+  r.ok = r.violations == 0;
+  return r;
+}
+
+#endif
@@ -0,0 +1,238 @@
+// 단일 출발점 최단 경로 (Dijkstra) - PC 전용, CsrGraph 위에서 동작
+//   - dialShortestPaths:  버킷 큐 (Dial). 가중치가 작은 정수일 때 O(m + D)
+//                         (D = 최대 거리) 버킷 C+1개를 원형으로 재사용 (C = 최대 가중치)
+//   - radixShortestPaths: radix heap. 꺼낸 키가 단조 증가하는 점을 이용해
+//                         키를 "마지막으로 꺼낸 값과 다른 최상위 비트" 버킷에 둠
+//                         원소 하나가 버킷을 옮기는 횟수 <= 64
+//   - shortestPaths:      최대 가중치를 보고 둘 중 하나를 고름
+// 두 큐 모두 decrease-key 대신 새 항목을 넣고, 꺼낼 때 낡은 항목을 버림(lazy deletion)
+// 음수 가중치는 지원하지 않음 (false 반환)
+
+#ifndef SHORTEST_PATH_H
+#define SHORTEST_PATH_H
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "graph_csr.h"
+
+#define SP_UNREACHED INT64_MAX
+#define SP_NONE UINT32_MAX
+#define SP_DIAL_MAX_WEIGHT 4096 // 이보다 큰 가중치가 있으면 radix heap
+#define SP_DIAL_LIMIT (1 << 24)  // Dial을 직접 고를 때도 버킷 수는 이 이하
+
+// ============================================================================
+// 1. 결과
+// ============================================================================
+
+struct ShortestPathResult {
+  std::vector<int64_t> dist;         // 도달 못하면 SP_UNREACHED
+  std::vector<uint32_t> parentEdge;  // 최단 경로 트리 간선 (EdgeList 인덱스)
+  uint32_t settled = 0;              // 확정된 정점 수
+  uint64_t relaxed = 0;              // 거리를 줄인 완화 횟수
+  uint64_t scanned = 0;              // 훑은 인접 슬롯 수
+  uint64_t stale = 0;                // 버린 낡은 큐 항목 수
+
+  void reset(uint32_t n) {
+    dist.assign(n, SP_UNREACHED);
+    parentEdge.assign(n, SP_NONE);
+    settled = 0;
+    relaxed = 0;
+    scanned = 0;
+    stale = 0;
+  }
+
+  // 거리 합 (도달한 정점만) - 엔진끼리 결과 비교용
+  int64_t checksum() const {
+    int64_t sum = 0;
+    for (size_t v = 0; v < dist.size(); v++) {
+      if (dist[v] != SP_UNREACHED)
+        sum += dist[v];
+    }
+    return sum;
+  }
+};
+
+inline bool minMaxWeight(const CsrGraph &g, int32_t &lo, int32_t &hi) {
+  lo = 0;
+  hi = 0;
+  for (size_t k = 0; k < g.weights.size(); k++) {
+    if (g.weights[k] < lo)
+      lo = g.weights[k];
+    if (g.weights[k] > hi)
+      hi = g.weights[k];
+  }
+  if (lo < 0) {
+    std::fprintf(stderr, "shortest path: negative weight %d\n", lo);
+    return false;
+  }
+  return true;
+}
+
+// ============================================================================
+// 2. Dial (버킷 큐)
+// ============================================================================
+// 큐 안의 거리는 항상 [현재 거리, 현재 거리 + C] 범위라 버킷 C+1개로 충분
+
+inline bool dialShortestPaths(const CsrGraph &g, uint32_t source,
+                              ShortestPathResult &out) {
+  int32_t lo, maxWeight;
+  out.reset(g.nodeCount);
+  if (source >= g.nodeCount || !minMaxWeight(g, lo, maxWeight))
+    return false;
+  if (maxWeight > SP_DIAL_LIMIT) {
+    std::fprintf(stderr, "dial: max weight %d needs too many buckets\n",
+                 maxWeight);
+    return false;
+  }
+  const uint64_t bucketCount = (uint64_t)maxWeight + 1;
+  std::vector<std::vector<uint32_t>> buckets(bucketCount);
+  std::vector<char> done(g.nodeCount, 0);
+
+  out.dist[source] = 0;
+  buckets[0].push_back(source);
+  uint64_t queued = 1;
+  for (uint64_t d = 0; queued > 0; d++) {
+    std::vector<uint32_t> &bucket = buckets[d % bucketCount];
+    // 같은 버킷에 0 가중치 간선으로 새 항목이 붙을 수 있어 인덱스로 순회
+    for (size_t i = 0; i < bucket.size(); i++) {
+      const uint32_t u = bucket[i];
+      queued--;
+      if (done[u] || out.dist[u] != (int64_t)d) {
+        out.stale++;
+        continue;
+      }
+      done[u] = 1;
+      out.settled++;
+      for (uint64_t k = g.begin(u); k < g.end(u); k++) {
+        const uint32_t v = g.targets[k];
+        const int64_t nd = (int64_t)d + g.weights[k];
+        out.scanned++;
+        if (nd < out.dist[v]) {
+          out.dist[v] = nd;
+          out.parentEdge[v] = g.edgeIds[k];
+          out.relaxed++;
+          buckets[nd % bucketCount].push_back(v);
+          queued++;
+        }
+      }
+    }
+    bucket.clear();
+  }
+  return true;
+}
+
+// ============================================================================
+// 3. Radix heap
+// ============================================================================
+// 버킷 0: last와 같은 키, 버킷 i (1..64): last와 처음 다른 비트가 i-1번인 키
+// popMin: 버킷 0이 비었으면 가장 낮은 비어 있지 않은 버킷의 최솟값을 last로 삼고
+//         그 버킷 원소를 더 낮은 버킷으로 재분배 (키가 last에 가까워질수록 내려감)
+
+class RadixHeap {
+public:
+  RadixHeap() : last_(0), size_(0) {}
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  // key >= 마지막으로 꺼낸 키 (단조성) 이어야 함
+  void push(uint64_t key, uint32_t value) {
+    buckets_[bucketOf(key)].push_back(Item{key, value});
+    size_++;
+  }
+
+  void popMin(uint64_t &key, uint32_t &value) {
+    if (buckets_[0].empty()) {
+      int i = 1;
+      while (buckets_[i].empty())
+        i++;
+      std::vector<Item> &from = buckets_[i];
+      uint64_t lowest = from[0].key;
+      for (size_t j = 1; j < from.size(); j++) {
+        if (from[j].key < lowest)
+          lowest = from[j].key;
+      }
+      last_ = lowest;
+      for (size_t j = 0; j < from.size(); j++)
+        buckets_[bucketOf(from[j].key)].push_back(from[j]);
+      from.clear();
+    }
+    Item item = buckets_[0].back();
+    buckets_[0].pop_back();
+    size_--;
+    key = item.key;
+    value = item.value;
+  }
+
+private:
+  struct Item {
+    uint64_t key;
+    uint32_t value;
+  };
+
+  int bucketOf(uint64_t key) const {
+    return key == last_ ? 0 : 64 - __builtin_clzll(key ^ last_);
+  }
+
+  std::vector<Item> buckets_[65];
+  uint64_t last_;
+  size_t size_;
+};
+
+inline bool radixShortestPaths(const CsrGraph &g, uint32_t source,
+                               ShortestPathResult &out) {
+  int32_t lo, hi;
+  out.reset(g.nodeCount);
+  if (source >= g.nodeCount || !minMaxWeight(g, lo, hi))
+    return false;
+  std::vector<char> done(g.nodeCount, 0);
+  RadixHeap heap;
+
+  out.dist[source] = 0;
+  heap.push(0, source);
+  while (!heap.empty()) {
+    uint64_t d;
+    uint32_t u;
+    heap.popMin(d, u);
+    if (done[u] || out.dist[u] != (int64_t)d) {
+      out.stale++;
+      continue;
+    }
+    done[u] = 1;
+    out.settled++;
+    for (uint64_t k = g.begin(u); k < g.end(u); k++) {
+      const uint32_t v = g.targets[k];
+      const int64_t nd = (int64_t)d + g.weights[k];
+      out.scanned++;
+      if (nd < out.dist[v]) {
+        out.dist[v] = nd;
+        out.parentEdge[v] = g.edgeIds[k];
+        out.relaxed++;
+        heap.push((uint64_t)nd, v);
+      }
+    }
+  }
+  return true;
+}
+
+// ============================================================================
+// 4. 진입점
+// ============================================================================
+
+// 사용한 엔진 이름을 engine에 (nullptr 가능)
+inline bool shortestPaths(const CsrGraph &g, uint32_t source,
+                          ShortestPathResult &out,
+                          const char **engine = nullptr) {
+  int32_t lo, hi;
+  if (!minMaxWeight(g, lo, hi))
+    return false;
+  const bool dial = hi <= SP_DIAL_MAX_WEIGHT;
+  if (engine)
+    *engine = dial ? "dial" : "radix";
+  return dial ? dialShortestPaths(g, source, out)
+              : radixShortestPaths(g, source, out);
+}
+
+#endif
@@ -6,9 +6,11 @@
 #include <chrono>
 #include <cmath>
 #include <cstdint>
+#include <cerrno>
 #include <cstdio>
 #include <math.h>
 #include <thread>
+#include <time.h>
 
 #define F(x) x
 #define HEX 16
@@ -18,6 +20,28 @@ inline void delay(unsigned long ms) {
   std::this_thread::sleep_for(std::chrono::milliseconds(ms));
 }
 
+inline void delayMicroseconds(unsigned int us) {
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+// 단조 시계 (clock_nanosleep TIMER_ABSTIME과 같은 CLOCK_MONOTONIC 기준)
+struct timespec monotonicOrigin() {
+  static struct timespec origin = [] {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts;
+  }();
+  return origin;
+}
+
+unsigned long micros() {
+  struct timespec origin = monotonicOrigin();
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (unsigned long)((long long)(now.tv_sec - origin.tv_sec) * 1000000LL +
+                         (now.tv_nsec - origin.tv_nsec) / 1000);
+}
+
 struct SerialType {
   void begin(unsigned long) {}
 
@@ -77,17 +101,43 @@ struct SerialType {
 #define NEO_GRB 0
 #define NEO_KHZ800 0
 
+// WS2812 전송 시간 모델 (800kHz, LED당 24bit x 1.25us)
+// 실제 show()는 전송 동안 인터럽트를 끄므로 시리얼 수신, millis(), 자석 스캔이 멈춤
+#define WS2812_US_PER_LED 30
+#define WS2812_LATCH_US 300        // 래치(reset) 최소 간격 (WS2812B)
+#define WS2812_MILLIS_TICK_US 1024 // AVR timer0 오버플로 주기 (1개만 보류됨)
+#define WS2812_UART_BYTE_US 87     // 115200bps에서 1바이트 수신 시간
+#define WS2812_UART_FIFO 2         // AVR UART 수신 버퍼 (바이트)
+#ifndef WS2812_SIMULATE_TIMING
+#define WS2812_SIMULATE_TIMING 0 // 1이면 show()가 전송 시간만큼 실제로 대기 (-D로 켬)
+#endif
+
 class Adafruit_NeoPixel {
 public:
   Adafruit_NeoPixel(int n, int /*pin*/, int /*flags*/)
-      : _n(n), _brightness(20) {
+      : _n(n), _brightness(20), _shows(0), _busyUs(0), _maxIrqOffUs(0),
+        _lostMillisUs(0), _rxOverrunBytes(0) {
     _pixels = new uint32_t[_n];
     clear();
   }
   ~Adafruit_NeoPixel() { delete[] _pixels; }
 
   void begin() {}
-  void show() {}
+  void show() {
+    unsigned long transferUs = (unsigned long)_n * WS2812_US_PER_LED;
+    _shows++;
+    _busyUs += transferUs;
+    if (transferUs > _maxIrqOffUs)
+      _maxIrqOffUs = transferUs;
+    if (transferUs > WS2812_MILLIS_TICK_US)
+      _lostMillisUs += transferUs - WS2812_MILLIS_TICK_US;
+    unsigned long rxBytes = transferUs / WS2812_UART_BYTE_US;
+    if (rxBytes > WS2812_UART_FIFO)
+      _rxOverrunBytes += rxBytes - WS2812_UART_FIFO;
+#if WS2812_SIMULATE_TIMING
+    delayMicroseconds(transferUs);
+#endif
+  }
 
   void setBrightness(uint8_t b) { _brightness = b; }
   uint8_t getBrightness() const { return _brightness; }
@@ -111,10 +161,25 @@ public:
     return 0;
   }
 
+  // 전송 시간 모델 요약: 누적 점유 시간, 최대 인터럽트 차단 구간, 최대 프레임 속도
+  void printTransferStats() const {
+    unsigned long transferUs = (unsigned long)_n * WS2812_US_PER_LED;
+    std::printf("WS2812: leds=%d shows=%lu busy_ms=%lu irq_off_max_us=%lu "
+                "millis_lost_ms=%lu max_fps=%lu rx_overrun_bytes=%lu\n",
+                _n, _shows, _busyUs / 1000, _maxIrqOffUs, _lostMillisUs / 1000,
+                1000000UL / (transferUs + WS2812_LATCH_US), _rxOverrunBytes);
+    std::fflush(stdout);
+  }
+
 private:
   int _n;
   uint8_t _brightness;
   uint32_t *_pixels;
+  unsigned long _shows;
+  unsigned long _busyUs;       // show()에 쓰인 누적 시간
+  unsigned long _maxIrqOffUs;  // 가장 긴 인터럽트 차단 구간
+  unsigned long _lostMillisUs; // 차단 중 놓친 timer0 tick
+  unsigned long _rxOverrunBytes; // 수신이 계속됐다면 차단 중 넘쳤을 UART 바이트
 };
 
 #else
@@ -164,6 +229,152 @@ int xyToIndex(int x, int y) {
 // 4. 유틸리티 함수
 // ============================================================================
 
+// 구간별 타이밍 (알고리즘 / 그리기 / 시리얼 출력)
+// -DPROFILE_PHASES=1로 빌드하면 활성화, 아니면 매크로가 모두 빈 코드가 됨
+// 중첩된 구간은 자기 시간만 기록 (예: 그리기 안의 serialPrintFrame은 io로 분리)
+#ifndef PROFILE_PHASES
+#define PROFILE_PHASES 0
+#endif
+
+#if PROFILE_PHASES
+enum Phase { PHASE_ALGO, PHASE_RENDER, PHASE_IO, PHASE_COUNT };
+
+#ifdef TARGET_PC
+#define PHASE_UNIT "ns"
+#define PHASE_SUB_BITS 2 // 2의 거듭제곱 구간을 4칸으로 나눔 (오차 25% 이내)
+static inline uint32_t phaseClock() {
+  return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+#else
+#define PHASE_UNIT "us"
+#define PHASE_SUB_BITS 0 // SRAM 절약: 2의 거듭제곱 단위
+static inline uint32_t phaseClock() { return micros(); }
+#endif
+
+#define PHASE_BUCKETS ((33 - PHASE_SUB_BITS) << PHASE_SUB_BITS)
+
+struct PhaseHistogram {
+  uint32_t count;
+  uint32_t minValue;
+  uint32_t maxValue;
+  uint32_t buckets[PHASE_BUCKETS];
+};
+
+static PhaseHistogram phaseHist[PHASE_COUNT];
+
+// 로그 스케일 버킷 번호
+static uint8_t phaseBucket(uint32_t v) {
+  if (v < (1UL << PHASE_SUB_BITS))
+    return (uint8_t)v;
+  uint8_t msb = 31;
+  while (!(v & (1UL << msb)))
+    msb--;
+  uint8_t sub = (v >> (msb - PHASE_SUB_BITS)) & ((1 << PHASE_SUB_BITS) - 1);
+  return ((msb - PHASE_SUB_BITS + 1) << PHASE_SUB_BITS) + sub;
+}
+
+// 버킷이 담당하는 최대값
+static uint32_t phaseBucketUpper(uint8_t bucket) {
+  if (bucket < (1 << PHASE_SUB_BITS))
+    return bucket;
+  uint8_t msb = (bucket >> PHASE_SUB_BITS) + PHASE_SUB_BITS - 1;
+  uint32_t sub = bucket & ((1 << PHASE_SUB_BITS) - 1);
+  uint32_t lower = (1UL << msb) | (sub << (msb - PHASE_SUB_BITS));
+  return lower + (1UL << (msb - PHASE_SUB_BITS)) - 1;
+}
+
+void phaseRecord(uint8_t phase, uint32_t elapsed) {
+  PhaseHistogram &h = phaseHist[phase];
+  if (h.count == 0 || elapsed < h.minValue)
+    h.minValue = elapsed;
+  if (elapsed > h.maxValue)
+    h.maxValue = elapsed;
+  h.count++;
+  h.buckets[phaseBucket(elapsed)]++;
+}
+
+uint32_t phaseQuantile(uint8_t phase, uint32_t permille) {
+  PhaseHistogram &h = phaseHist[phase];
+  uint32_t rank = (h.count * permille + 999) / 1000;
+  uint32_t seen = 0;
+  for (int i = 0; i < PHASE_BUCKETS; i++) {
+    seen += h.buckets[i];
+    if (seen >= rank && seen > 0) {
+      uint32_t upper = phaseBucketUpper(i);
+      return upper < h.maxValue ? upper : h.maxValue;
+    }
+  }
+  return h.maxValue;
+}
+
+// 스코프 타이머: 생성~소멸 구간을 기록, 안쪽 구간이 열리면 바깥 구간은 잠시 멈춤
+struct PhaseScope {
+  static PhaseScope *active;
+  PhaseScope *parent;
+  uint32_t start;
+  uint32_t elapsed;
+  uint8_t phase;
+  bool merged; // 같은 구간 안에서 다시 열린 경우 바깥 구간에 합침
+
+  explicit PhaseScope(uint8_t p) : parent(active), elapsed(0), phase(p) {
+    merged = parent && parent->phase == p;
+    if (merged)
+      return;
+    start = phaseClock();
+    if (parent)
+      parent->elapsed += start - parent->start;
+    active = this;
+  }
+
+  ~PhaseScope() {
+    if (merged)
+      return;
+    uint32_t now = phaseClock();
+    phaseRecord(phase, elapsed + (now - start));
+    active = parent;
+    if (parent)
+      parent->start = now;
+  }
+};
+
+PhaseScope *PhaseScope::active = 0;
+
+void serialPrintPhaseStats() {
+  static const char *names[PHASE_COUNT] = {"algo", "render", "io"};
+  for (uint8_t p = 0; p < PHASE_COUNT; p++) {
+    Serial.print(F("PHASE:"));
+    Serial.print(names[p]);
+    Serial.print(F(" n="));
+    Serial.print((unsigned long)phaseHist[p].count);
+    Serial.print(F(" min="));
+    Serial.print((unsigned long)phaseHist[p].minValue);
+    Serial.print(F(" p50="));
+    Serial.print((unsigned long)phaseQuantile(p, 500));
+    Serial.print(F(" p99="));
+    Serial.print((unsigned long)phaseQuantile(p, 990));
+    Serial.print(F(" max="));
+    Serial.print((unsigned long)phaseHist[p].maxValue);
+    Serial.println(F(" " PHASE_UNIT));
+  }
+}
+
+// 실행 시작마다 호출: 보고가 그 실행의 구간만 담도록 히스토그램을 비움
+void phaseReset() {
+  for (uint8_t p = 0; p < PHASE_COUNT; p++)
+    phaseHist[p] = PhaseHistogram();
+}
+
+#define PHASE_SCOPE(p) PhaseScope phaseScope(p)
+#define PHASE_REPORT() serialPrintPhaseStats()
+#define PHASE_RESET() phaseReset()
+#else
+#define PHASE_SCOPE(p)
+#define PHASE_REPORT()
+#define PHASE_RESET()
+#endif
+
 void printHex(uint8_t value) {
   if (value < 16)
     Serial.print("0");
@@ -171,6 +382,7 @@ void printHex(uint8_t value) {
 }
 
 void serialPrintFrame() {
+  PHASE_SCOPE(PHASE_IO);
   Serial.print(F("FRAME:"));
   Serial.println(currentFrameNumber);
 
@@ -211,6 +423,7 @@ void setPixel(int x, int y, uint8_t r, uint8_t g, uint8_t b) {
 void clearDisplay() { strip.clear(); }
 
 void showDisplay() {
+  PHASE_SCOPE(PHASE_IO);
   uint8_t currentBrightness = strip.getBrightness();
   if (currentBrightness != lastBrightness) {
     Serial.print(F("BRIGHTNESS:"));
@@ -224,10 +437,86 @@ void showDisplay() {
 
 void setBrightness(uint8_t level) { strip.setBrightness(level); }
 
+// 프레임 페이싱 (절대 마감 기준)
+// 각 스텝의 목표 표시 시각 = 이전 목표 시각 + 지연 시간
+// 그리기/시리얼 출력 시간이 지연에 더해지지 않으므로 오래 실행해도 오차가 누적되지 않음
+#define PACE_MAX_CATCHUP_US 250000UL // 이보다 늦으면 일정을 현재 시각으로 재설정
+
+static unsigned long frameDeadline = 0; // 다음 프레임 목표 시각 (micros)
+static bool frameDeadlineSet = false;
+static unsigned long pacedFrames = 0;
+static unsigned long lateFrames = 0;
+static unsigned long maxLateUs = 0;
+static unsigned long totalLateUs = 0;
+
+void sleepUntilMicros(unsigned long target) {
+#ifdef TARGET_PC
+  struct timespec ts = monotonicOrigin();
+  ts.tv_sec += target / 1000000UL;
+  ts.tv_nsec += (long)(target % 1000000UL) * 1000L;
+  if (ts.tv_nsec >= 1000000000L) {
+    ts.tv_sec++;
+    ts.tv_nsec -= 1000000000L;
+  }
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+  }
+#else
+  // 대부분은 delay()로 자고 마지막 1ms 정도만 micros()로 맞춤
+  long remaining = (long)(target - micros());
+  if (remaining > 2000)
+    delay((remaining - 1000) / 1000);
+  while ((long)(target - micros()) > 0) {
+  }
+#endif
+}
+
 void hardwareDelay(unsigned long ms) {
   if (animationSpeed <= 0.0)
     animationSpeed = 1.0;
-  delay((unsigned long)(ms / animationSpeed));
+
+  unsigned long now = micros();
+  if (!frameDeadlineSet) {
+    frameDeadline = now;
+    frameDeadlineSet = true;
+  }
+  frameDeadline += (unsigned long)(ms * 1000.0 / animationSpeed);
+  pacedFrames++;
+
+  long slack = (long)(frameDeadline - now);
+  if (slack >= 0) {
+    sleepUntilMicros(frameDeadline);
+    return;
+  }
+
+  // 이미 목표 시각을 지남: 지각 프레임으로 기록
+  unsigned long late = (unsigned long)(-slack);
+  lateFrames++;
+  totalLateUs += late;
+  if (late > maxLateUs)
+    maxLateUs = late;
+  if (late > PACE_MAX_CATCHUP_US)
+    frameDeadline = now;
+}
+
+// 실행마다 새로 시작: 통계를 비우고, 이전 실행이나 그 뒤의 대기 시간이
+// 첫 프레임의 지각으로 잡히지 않도록 일정도 다음 hardwareDelay()에서 다시 잡음
+void pacingReset() {
+  frameDeadlineSet = false;
+  pacedFrames = 0;
+  lateFrames = 0;
+  maxLateUs = 0;
+  totalLateUs = 0;
+}
+
+void serialPrintPacingStats() {
+  Serial.print(F("PACING: frames="));
+  Serial.print(pacedFrames);
+  Serial.print(F(" late="));
+  Serial.print(lateFrames);
+  Serial.print(F(" max_late_us="));
+  Serial.print(maxLateUs);
+  Serial.print(F(" avg_late_us="));
+  Serial.println(lateFrames > 0 ? totalLateUs / lateFrames : 0UL);
 }
 
 // ============================================================================
@@ -265,13 +554,44 @@ int T_len = 16;
 int P_len = 6;
 
 #define ALPHABET_SIZE 8
-int badChar[ALPHABET_SIZE]; // Bad Character Table
+#define MAX_PATTERN 16 // 패턴 최대 길이 (LED 한 줄)
+int badChar[ALPHABET_SIZE];       // Bad Character Table (마지막 출현 위치)
+int horspoolShift[ALPHABET_SIZE]; // 창 마지막 문자 기준 이동량 (Horspool)
+int goodSuffix[MAX_PATTERN + 1];  // [j+1]: P[j] 불일치 시 이동량, [0]: 전체 일치 시
 int matchedPositions[10];
 int matchedCount = 0;
 int totalComparisons = 0;
 
+// 이동 규칙 엔진: 비교는 모두 같은 우->좌 순서, 창을 옮기는 양만 다름
+//   BAD_CHAR: 불일치는 bad character, 전체 일치는 T[s+m] 기준 한 걸음 (기존 동작)
+//   FULL_BM : max(bad character, good suffix), 전체 일치는 패턴 주기만큼
+//             주기적인 텍스트에서도 창마다 비교가 O(m)로 쌓이지 않음
+//   HORSPOOL: 불일치 위치와 상관없이 창 마지막 문자 T[s+m-1]로만
+//   SUNDAY  : 창 바로 다음 문자 T[s+m]로만 (최대 m+1칸)
+enum MatchEngine : uint8_t {
+  ENGINE_BAD_CHAR,
+  ENGINE_FULL_BM,
+  ENGINE_HORSPOOL,
+  ENGINE_SUNDAY,
+  ENGINE_COUNT
+};
+
+// 엔진별 이동 통계 (마지막 실행 기준)
+struct ShiftStats {
+  unsigned long windows;     // 시도한 창(shift) 수
+  unsigned long comparisons; // 문자 비교 수
+  unsigned long shiftTotal;  // 이동량 합
+  int shiftMin;
+  int shiftMax;
+  unsigned long goodSuffixWins; // FULL_BM: good suffix 쪽이 더 멀리 간 횟수
+};
+
+ShiftStats engineStats[ENGINE_COUNT];
+MatchEngine currentEngine = ENGINE_BAD_CHAR;
+
 void drawMatchingState(int shift, int compareIdx, bool isMatch,
                        bool showBadChar) {
+  PHASE_SCOPE(PHASE_RENDER);
   clearDisplay();
 
   // 상단: T 패턴 (행 0)
@@ -345,38 +665,216 @@ void drawMatchingState(int shift, int compareIdx, bool isMatch,
   showDisplay();
 }
 
-void computeBadCharTable() {
-  Serial.println(F("\n=== Computing Bad Character Table ==="));
-
-  // 초기화: 모든 문자는 패턴에 없음 (-1)
+// pat[0..m-1]로 세 이동 표를 만듦 (출력 없음)
+void buildShiftTables(const int *pat, int m) {
+  // 초기화: 모든 문자는 패턴에 없음 (-1), Horspool은 창 전체를 건너뜀
   for (int i = 0; i < ALPHABET_SIZE; i++) {
     badChar[i] = -1;
+    horspoolShift[i] = m;
   }
 
   // 패턴의 각 문자에 대해 마지막 출현 위치 저장
-  for (int i = 0; i < P_len; i++) {
-    badChar[P[i]] = i;
+  for (int i = 0; i < m; i++) {
+    badChar[pat[i]] = i;
   }
 
-  Serial.print(F("Bad Character Table: "));
-  for (int i = 0; i < ALPHABET_SIZE; i++) {
-    Serial.print(badChar[i]);
+  // Horspool: 마지막 문자를 뺀 P[0..m-2]에서의 마지막 출현까지 거리
+  for (int i = 0; i < m - 1; i++) {
+    horspoolShift[pat[i]] = m - 1 - i;
+  }
+
+  // Good suffix (strong rule)
+  // border[i]: 접미사 P[i..m-1]의 가장 긴 진 테두리(border)가 시작하는 위치
+  // 1) 맞은 접미사 P[i..]가 다른 문자 뒤에서 다시 나오면 그 자리로
+  int border[MAX_PATTERN + 1];
+  for (int i = 0; i <= m; i++) {
+    goodSuffix[i] = 0;
+  }
+  int i = m;
+  int j = m + 1;
+  border[i] = j;
+  while (i > 0) {
+    while (j <= m && pat[i - 1] != pat[j - 1]) {
+      if (goodSuffix[j] == 0) {
+        goodSuffix[j] = j - i;
+      }
+      j = border[j];
+    }
+    i--;
+    j--;
+    border[i] = j;
+  }
+
+  // 2) 나머지: 맞은 부분의 끝이 패턴 접두사와 겹치는 가장 긴 자리로
+  //    goodSuffix[0]은 패턴 전체의 주기 (전체 일치 후 이동량)
+  j = border[0];
+  for (i = 0; i <= m; i++) {
+    if (goodSuffix[i] == 0) {
+      goodSuffix[i] = j;
+    }
+    if (i == j) {
+      j = border[j];
+    }
+  }
+}
+
+void printTable(const int *table, int count) {
+  for (int i = 0; i < count; i++) {
+    Serial.print(table[i]);
     Serial.print(" ");
   }
   Serial.println();
+}
+
+void computeBadCharTable() {
+  PHASE_SCOPE(PHASE_ALGO);
+  Serial.println(F("\n=== Computing Bad Character Table ==="));
+
+  buildShiftTables(P, P_len);
+
+  Serial.print(F("Bad Character Table: "));
+  printTable(badChar, ALPHABET_SIZE);
+  Serial.print(F("Horspool Shift Table: "));
+  printTable(horspoolShift, ALPHABET_SIZE);
+  Serial.print(F("Good Suffix Table: "));
+  printTable(goodSuffix, P_len + 1);
   Serial.println(F("=== Bad Character Table Computed ===\n"));
 }
 
 int maxVal(int a, int b) { return (a > b) ? a : b; }
 
+void printEngineName(MatchEngine engine) {
+  switch (engine) {
+  case ENGINE_FULL_BM:
+    Serial.print(F("Full BM"));
+    break;
+  case ENGINE_HORSPOOL:
+    Serial.print(F("Horspool"));
+    break;
+  case ENGINE_SUNDAY:
+    Serial.print(F("Sunday"));
+    break;
+  default:
+    Serial.print(F("Bad-Char"));
+    break;
+  }
+}
+
+void resetShiftStats(ShiftStats &stats) {
+  stats.windows = 0;
+  stats.comparisons = 0;
+  stats.shiftTotal = 0;
+  stats.shiftMin = 0;
+  stats.shiftMax = 0;
+  stats.goodSuffixWins = 0;
+}
+
+// 창 text[shift..shift+m-1]에서 P[j] 불일치 (j < 0이면 전체 일치) 후 이동량
+// 항상 1 이상. stats에 기록하고, verbose면 적용한 규칙을 출력
+int nextShift(MatchEngine engine, const int *text, int n, int m, int shift,
+              int j, ShiftStats &stats, bool verbose) {
+  int amount;
+  switch (engine) {
+  case ENGINE_FULL_BM: {
+    int gsShift = goodSuffix[j + 1];
+    int bcShift = (j >= 0) ? j - badChar[text[shift + j]] : 0;
+    amount = maxVal(bcShift, gsShift);
+    if (gsShift > bcShift) {
+      stats.goodSuffixWins++;
+    }
+    if (verbose) {
+      Serial.print(gsShift > bcShift ? F("  Good Suffix Rule: shift by ")
+                                     : F("  Bad Character Rule: shift by "));
+      Serial.println(amount);
+    }
+    break;
+  }
+  case ENGINE_HORSPOOL:
+    amount = horspoolShift[text[shift + m - 1]];
+    if (verbose) {
+      Serial.print(F("  Horspool Rule: shift by "));
+      Serial.println(amount);
+    }
+    break;
+  case ENGINE_SUNDAY:
+    // 창 다음 문자가 없으면 더 볼 창도 없음
+    amount = (shift + m < n) ? m - badChar[text[shift + m]] : m + 1;
+    if (verbose) {
+      Serial.print(F("  Sunday Rule: shift by "));
+      Serial.println(amount);
+    }
+    break;
+  default:
+    if (j >= 0) {
+      amount = maxVal(1, j - badChar[text[shift + j]]);
+      if (verbose) {
+        Serial.print(F("  Bad Character Rule: shift by "));
+        Serial.println(amount);
+      }
+    } else {
+      // 패턴 끝을 넘어서는 문자가 있으면 그것 기준, 아니면 1칸만 이동
+      amount = (shift + m < n) ? m - badChar[text[shift + m]] : 1;
+    }
+    break;
+  }
+
+  if (stats.windows == 0 || amount < stats.shiftMin) {
+    stats.shiftMin = amount;
+  }
+  if (amount > stats.shiftMax) {
+    stats.shiftMax = amount;
+  }
+  stats.windows++;
+  stats.shiftTotal += amount;
+  return amount;
+}
+
+// 평균 이동량을 소수 첫째 자리까지 (정수 연산)
+void printAverageShift(const ShiftStats &stats) {
+  unsigned long tenths =
+      stats.windows ? (stats.shiftTotal * 10 + stats.windows / 2) / stats.windows
+                    : 0;
+  Serial.print(tenths / 10);
+  Serial.print('.');
+  Serial.print(tenths % 10);
+}
+
+void serialPrintShiftStats(MatchEngine engine) {
+  const ShiftStats &stats = engineStats[engine];
+  Serial.print(F("Shift stats ["));
+  printEngineName(engine);
+  Serial.print(F("]: windows="));
+  Serial.print(stats.windows);
+  Serial.print(F(" comparisons="));
+  Serial.print(stats.comparisons);
+  Serial.print(F(" shift_avg="));
+  printAverageShift(stats);
+  Serial.print(F(" min="));
+  Serial.print(stats.shiftMin);
+  Serial.print(F(" max="));
+  Serial.print(stats.shiftMax);
+  if (engine == ENGINE_FULL_BM) {
+    Serial.print(F(" good_suffix_wins="));
+    Serial.print(stats.goodSuffixWins);
+  }
+  Serial.println();
+}
+
 void boyerMooreStringMatching() {
+  pacingReset();
+  PHASE_RESET();
   Serial.println(F("\n=== Boyer-Moore String Matching Start (Mirrored) ==="));
+  Serial.print(F("Engine: "));
+  printEngineName(currentEngine);
+  Serial.println();
 
   int n = T_len;
   int m = P_len;
 
   matchedCount = 0;
   totalComparisons = 0;
+  ShiftStats &stats = engineStats[currentEngine];
+  resetShiftStats(stats);
 
   drawMatchingState(0, -1, false, true);
   hardwareDelay(1000);
@@ -393,6 +891,7 @@ void boyerMooreStringMatching() {
     // 오른쪽부터 비교하면서 일치하는 동안 계속
     while (j >= 0) {
       totalComparisons++;
+      stats.comparisons++;
 
       drawMatchingState(shift, j, false, true);
       hardwareDelay(500);
@@ -423,28 +922,118 @@ void boyerMooreStringMatching() {
       if (matchedCount < 10) {
         matchedPositions[matchedCount++] = shift;
       }
-
-      // 다음 매칭을 찾기 위해 shift
-      // 패턴 끝을 넘어서는 문자가 있으면 그것 기준, 아니면 1칸만 이동
-      shift += (shift + m < n) ? m - badChar[T[shift + m]] : 1;
-    } else {
-      // 불일치 발생 - Bad Character Rule 적용
-      int badCharShift = j - badChar[T[shift + j]];
-      Serial.print(F("  Bad Character Rule: shift by "));
-      Serial.println(maxVal(1, badCharShift));
-
-      shift += maxVal(1, badCharShift);
     }
 
+    // 다음 창으로 이동 (불일치/전체 일치 모두 엔진 규칙으로)
+    shift += nextShift(currentEngine, T, n, m, shift, j, stats, true);
+
     hardwareDelay(300);
   }
 
   Serial.print(F("Total comparisons: "));
   Serial.println(totalComparisons);
+  serialPrintShiftStats(currentEngine);
+  serialPrintPacingStats();
+  PHASE_REPORT();
+#ifdef TARGET_PC
+  strip.printTransferStats();
+#endif
   Serial.println(F("=== Boyer-Moore String Matching End ===\n"));
   hardwareDelay(2000);
 }
 
+// 엔진을 한 바퀴 모두 돌린 뒤 같은 텍스트에서의 비교/이동량을 나란히 출력
+void serialPrintEngineSummary() {
+  Serial.println(F("=== Shift Engine Summary ==="));
+  for (int e = 0; e < ENGINE_COUNT; e++) {
+    serialPrintShiftStats((MatchEngine)e);
+  }
+  Serial.println(F("============================\n"));
+}
+
+#ifdef TARGET_PC
+// ============================================================================
+// 헤드리스 엔진 비교 (PC 전용, --compare [n])
+// ============================================================================
+// 시각화 없이 같은 우->좌 비교 루프를 엔진마다 돌려 작업 부하별 비교 수와 이동량을 봄
+//   periodic-miss : 텍스트 0000..., 패턴 1000 0000 (bad char만으로는 창마다 1칸, m번 비교)
+//   periodic-hit  : 텍스트 (0001)*, 패턴 0001 0001 (4칸마다 전체 일치)
+//   random        : 알파벳 8글자 균등 난수, 데모 패턴
+//   demo          : LED 데모의 T / P
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// 일치한 창 수를 돌려줌
+int matchHeadless(MatchEngine engine, const int *text, int n, const int *pat,
+                  int m, ShiftStats &stats) {
+  resetShiftStats(stats);
+  int found = 0;
+  int shift = 0;
+  while (shift <= n - m) {
+    int j = m - 1;
+    while (j >= 0) {
+      stats.comparisons++;
+      if (pat[j] != text[shift + j])
+        break;
+      j--;
+    }
+    if (j < 0)
+      found++;
+    shift += nextShift(engine, text, n, m, shift, j, stats, false);
+  }
+  return found;
+}
+
+void compareWorkload(const char *name, const std::vector<int> &text,
+                     const int *pat, int m) {
+  buildShiftTables(pat, m);
+  std::printf("%-14s n=%zu m=%d\n", name, text.size(), m);
+  for (int e = 0; e < ENGINE_COUNT; e++) {
+    ShiftStats stats;
+    int found = matchHeadless((MatchEngine)e, text.data(), (int)text.size(),
+                              pat, m, stats);
+    std::printf("  ");
+    printEngineName((MatchEngine)e);
+    std::printf("\tmatches=%d comparisons=%lu cmp/char=%.3f windows=%lu "
+                "shift_avg=%.2f min=%d max=%d",
+                found, stats.comparisons,
+                text.empty() ? 0.0 : (double)stats.comparisons / text.size(),
+                stats.windows,
+                stats.windows ? (double)stats.shiftTotal / stats.windows : 0.0,
+                stats.shiftMin, stats.shiftMax);
+    if (e == ENGINE_FULL_BM)
+      std::printf(" good_suffix_wins=%lu", stats.goodSuffixWins);
+    std::printf("\n");
+  }
+}
+
+int compareEngines(int n) {
+  static const int periodicMiss[] = {1, 0, 0, 0, 0, 0, 0, 0};
+  static const int periodicHit[] = {0, 0, 0, 1, 0, 0, 0, 1};
+  std::vector<int> text((size_t)n);
+
+  for (int i = 0; i < n; i++)
+    text[i] = 0;
+  compareWorkload("periodic-miss", text, periodicMiss, 8);
+
+  for (int i = 0; i < n; i++)
+    text[i] = (i % 4 == 3) ? 1 : 0;
+  compareWorkload("periodic-hit", text, periodicHit, 8);
+
+  uint32_t seed = 12345;
+  for (int i = 0; i < n; i++) {
+    seed = seed * 1103515245u + 12345u;
+    text[i] = (int)((seed >> 16) % ALPHABET_SIZE);
+  }
+  compareWorkload("random", text, P, P_len);
+
+  compareWorkload("demo", std::vector<int>(T, T + T_len), P, P_len);
+  return 0;
+}
+#endif
+
 // ============================================================================
 // 8. Setup & Loop
 // ============================================================================
@@ -503,11 +1092,21 @@ void loop() {
 
   boyerMooreStringMatching();
 
+  // 다음 실행은 다음 엔진으로, 한 바퀴 돌면 엔진별 통계를 나란히 출력
+  currentEngine = (MatchEngine)(currentEngine + 1);
+  if (currentEngine == ENGINE_COUNT) {
+    serialPrintEngineSummary();
+    currentEngine = ENGINE_BAD_CHAR;
+  }
+
   hardwareDelay(3000);
 }
 
 #ifdef TARGET_PC
-int main() {
+int main(int argc, char **argv) {
+  if (argc >= 2 && std::strcmp(argv[1], "--compare") == 0)
+    return compareEngines(argc >= 3 ? std::atoi(argv[2]) : 1 << 20);
+
   setup();
   while (true) {
     loop();
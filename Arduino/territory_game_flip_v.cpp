@@ -12,8 +12,10 @@
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
+#include <poll.h>
 #include <string>
 #include <thread>
+#include <unistd.h>
 
 #define F(x) x
 #define HEX 16
@@ -23,6 +25,18 @@
 #define HIGH 1
 #define LOW 0
 
+#ifdef DETERMINISTIC
+// 결정적 모드: 벽시계 대신 가상 시간을 사용 (delay는 즉시 반환하고 시간만 전진)
+static unsigned long virtualMicros = 0;
+
+inline void delay(unsigned long ms) { virtualMicros += ms * 1000UL; }
+
+inline void delayMicroseconds(int us) { virtualMicros += us; }
+
+unsigned long micros() { return virtualMicros; }
+
+unsigned long millis() { return virtualMicros / 1000UL; }
+#else
 // 시간 함수 모의
 inline void delay(unsigned long ms) {
   std::this_thread::sleep_for(std::chrono::milliseconds(ms));
@@ -38,6 +52,7 @@ unsigned long millis() {
   auto now = steady_clock::now();
   return duration_cast<milliseconds>(now - start).count();
 }
+#endif
 
 // GPIO 함수 모의
 void pinMode(int pin, int mode) {}
@@ -113,17 +128,43 @@ struct SerialMock {
 #define NEO_GRB 0
 #define NEO_KHZ800 0
 
+// WS2812 전송 시간 모델 (800kHz, LED당 24bit x 1.25us)
+// 실제 show()는 전송 동안 인터럽트를 끄므로 시리얼 수신, millis(), 자석 스캔이 멈춤
+#define WS2812_US_PER_LED 30
+#define WS2812_LATCH_US 300        // 래치(reset) 최소 간격 (WS2812B)
+#define WS2812_MILLIS_TICK_US 1024 // AVR timer0 오버플로 주기 (1개만 보류됨)
+#define WS2812_UART_BYTE_US 87     // 115200bps에서 1바이트 수신 시간
+#define WS2812_UART_FIFO 2         // AVR UART 수신 버퍼 (바이트)
+#ifndef WS2812_SIMULATE_TIMING
+#define WS2812_SIMULATE_TIMING 0 // 1이면 show()가 전송 시간만큼 실제로 대기 (-D로 켬)
+#endif
+
 class Adafruit_NeoPixel {
 public:
   Adafruit_NeoPixel(int n, int /*pin*/, int /*flags*/)
-      : _n(n), _brightness(20) {
+      : _n(n), _brightness(20), _shows(0), _busyUs(0), _maxIrqOffUs(0),
+        _lostMillisUs(0), _rxOverrunBytes(0) {
     _pixels = new uint32_t[_n];
     clear();
   }
   ~Adafruit_NeoPixel() { delete[] _pixels; }
 
   void begin() {}
-  void show() {}
+  void show() {
+    unsigned long transferUs = (unsigned long)_n * WS2812_US_PER_LED;
+    _shows++;
+    _busyUs += transferUs;
+    if (transferUs > _maxIrqOffUs)
+      _maxIrqOffUs = transferUs;
+    if (transferUs > WS2812_MILLIS_TICK_US)
+      _lostMillisUs += transferUs - WS2812_MILLIS_TICK_US;
+    unsigned long rxBytes = transferUs / WS2812_UART_BYTE_US;
+    if (rxBytes > WS2812_UART_FIFO)
+      _rxOverrunBytes += rxBytes - WS2812_UART_FIFO;
+#if WS2812_SIMULATE_TIMING
+    delayMicroseconds(transferUs);
+#endif
+  }
   void setBrightness(uint8_t b) { _brightness = b; }
   uint8_t getBrightness() const { return _brightness; }
   void clear() {
@@ -146,10 +187,25 @@ public:
     return 0;
   }
 
+  // 전송 시간 모델 요약: 누적 점유 시간, 최대 인터럽트 차단 구간, 최대 프레임 속도
+  void printTransferStats() const {
+    unsigned long transferUs = (unsigned long)_n * WS2812_US_PER_LED;
+    std::printf("WS2812: leds=%d shows=%lu busy_ms=%lu irq_off_max_us=%lu "
+                "millis_lost_ms=%lu max_fps=%lu rx_overrun_bytes=%lu\n",
+                _n, _shows, _busyUs / 1000, _maxIrqOffUs, _lostMillisUs / 1000,
+                1000000UL / (transferUs + WS2812_LATCH_US), _rxOverrunBytes);
+    std::fflush(stdout);
+  }
+
 private:
   int _n;
   uint8_t _brightness;
   uint32_t *_pixels;
+  unsigned long _shows;
+  unsigned long _busyUs;       // show()에 쓰인 누적 시간
+  unsigned long _maxIrqOffUs;  // 가장 긴 인터럽트 차단 구간
+  unsigned long _lostMillisUs; // 차단 중 놓친 timer0 tick
+  unsigned long _rxOverrunBytes; // 수신이 계속됐다면 차단 중 넘쳤을 UART 바이트
 };
 
 #else
@@ -159,6 +215,7 @@ private:
 #include <Adafruit_NeoPixel.h>
 #ifdef __AVR__
 #include <avr/power.h>
+#include <avr/sleep.h>
 #endif
 #endif
 
@@ -192,6 +249,10 @@ private:
 #define USE_LED 1
 #define USE_SERIAL 1
 
+// 타이머 설정 (ms)
+#define BLINK_INTERVAL 200
+#define MAGNETIC_SCAN_INTERVAL 2
+
 // ============================================================================
 // 2. 자료형 정의 (Enums & Structs)
 // ============================================================================
@@ -230,6 +291,14 @@ static unsigned long lastInputTime = 0;
 static const unsigned long DEBOUNCE_DELAY = 200;
 static int lastNodeInput = -1;
 InputMode currentInputMode = INPUT_SERIAL;
+#if defined(TARGET_PC) && !defined(DETERMINISTIC)
+static bool stdinOpen = true;
+#endif
+
+// 타이머 핸들
+int blinkTimer = -1;
+int inputTimer = -1;
+bool blinkState = false;
 
 // 게임 상태
 Node gridNodes[TOTAL_NODES];
@@ -285,6 +354,25 @@ void showVictoryAnimation(int winnerPlayer);
 void showError(int nodeIdx);
 void processTurn(int selectedNode);
 
+// 타이머 휠 관련
+typedef void (*TimerCallback)();
+void timerWheelInit(unsigned long now);
+int timerCreate(TimerCallback callback);
+void timerStart(int id, unsigned long delayMs, unsigned long periodMs);
+void timerStop(int id);
+bool timerNextDeadline(unsigned long *deadline);
+void timerWheelAdvance(unsigned long now);
+bool idleUntilNextEvent();
+void blinkTask();
+void inputTask();
+
+// 결정적 시뮬레이션 관련 (PC 전용)
+#ifdef DETERMINISTIC
+int detPollScript();
+void detRecordFrame();
+bool detIdle(bool hasDeadline, unsigned long deadline);
+#endif
+
 // ============================================================================
 // 5. 입력 인터페이스 구현 (Input Implementation)
 // ============================================================================
@@ -323,7 +411,22 @@ void nodeToCoord(int node, int *row, int *col) {
 }
 
 int readMagneticInput() {
-#ifdef TARGET_PC
+#if defined(TARGET_PC) && defined(DETERMINISTIC)
+  // 스크립트 입력을 자석 감지로 간주, 디바운스는 가상 시간 기준
+  unsigned long currentTime = millis();
+
+  if (currentTime - lastInputTime < DEBOUNCE_DELAY) {
+    return -1;
+  }
+
+  int nodeNum = detPollScript();
+  if (nodeNum < 0 || nodeNum == lastNodeInput)
+    return -1;
+
+  lastInputTime = currentTime;
+  lastNodeInput = nodeNum;
+  return nodeNum;
+#elif defined(TARGET_PC)
   return -1;
 #else
   unsigned long currentTime = millis();
@@ -360,7 +463,16 @@ int readMagneticInput() {
 }
 
 int readSerialInput() {
-#ifdef TARGET_PC
+#if defined(TARGET_PC) && defined(DETERMINISTIC)
+  int node = detPollScript();
+  if (node >= 0 && node < TOTAL_NODES) {
+    if (node == lastNodeInput)
+      return -1;
+    lastNodeInput = node;
+    return node;
+  }
+  return -1;
+#elif defined(TARGET_PC)
   char buffer[10];
   if (fgets(buffer, sizeof(buffer), stdin)) {
     int node = atoi(buffer);
@@ -370,6 +482,8 @@ int readSerialInput() {
       lastNodeInput = node;
       return node;
     }
+  } else {
+    stdinOpen = false; // EOF: 더 이상 stdin을 기다리지 않음
   }
   return -1;
 #else
@@ -398,10 +512,15 @@ int readInput(InputMode mode) {
 
 void setInputMode(InputMode mode) {
   currentInputMode = mode;
-  if (mode == INPUT_MAGNETIC)
+  if (mode == INPUT_MAGNETIC) {
+    // 자석 모듈은 인터럽트가 없으므로 주기적으로 스캔
+    timerStart(inputTimer, MAGNETIC_SCAN_INTERVAL, MAGNETIC_SCAN_INTERVAL);
     Serial.println(F("Input mode: Magnetic sensor"));
-  else
+  } else {
+    // 시리얼은 수신 시 idleUntilNextEvent()가 깨워줌
+    timerStop(inputTimer);
     Serial.println(F("Input mode: Serial"));
+  }
 }
 
 // ============================================================================
@@ -506,6 +625,9 @@ void displayShow() {
   serialPrintBrightnessChange();
 #if USE_LED
   strip.show();
+#endif
+#ifdef DETERMINISTIC
+  detRecordFrame();
 #endif
   serialPrintFrame();
 }
@@ -872,13 +994,221 @@ void processTurn(int selectedNode) {
 }
 
 // ============================================================================
-// 8. 메인 Setup & Loop
+// 8. 타이머 휠 (Timer Wheel)
+// ============================================================================
+
+// 1ms tick 기준 4단계 x 16슬롯 계층형 타이머 휠
+// 레벨 0: 16ms, 레벨 1: 256ms, 레벨 2: 4096ms, 레벨 3: 65536ms 범위 담당
+// 하위 레벨 인덱스가 한 바퀴 돌 때마다 상위 레벨 슬롯을 아래로 내려보낸다
+// 타이머는 고정 풀(TIMER_MAX)에서 생성하므로 동적 메모리를 쓰지 않는다
+
+#define TW_LEVELS 4
+#define TW_SLOT_BITS 4
+#define TW_SLOTS (1 << TW_SLOT_BITS)
+#define TW_MASK (TW_SLOTS - 1)
+#define TW_RANGE (1UL << (TW_SLOT_BITS * TW_LEVELS))
+#define TIMER_MAX 8
+#define TIMER_NONE 0xFF
+
+struct Timer {
+  unsigned long expires;  // 만기 시각 (millis 기준)
+  unsigned long period;   // 0이면 one-shot, 아니면 주기(ms)
+  TimerCallback callback;
+  uint8_t next;           // 같은 슬롯의 다음 타이머
+  uint8_t level, slot;    // 연결된 위치 (취소 시 사용)
+  bool pending;           // 휠에 연결되어 있는지
+};
+
+static Timer timers[TIMER_MAX];
+static uint8_t timerCount = 0;
+static uint8_t wheel[TW_LEVELS][TW_SLOTS];
+static unsigned long wheelTime = 0; // 다음에 처리할 tick
+
+void timerWheelInit(unsigned long now) {
+  for (int level = 0; level < TW_LEVELS; level++)
+    for (int slot = 0; slot < TW_SLOTS; slot++)
+      wheel[level][slot] = TIMER_NONE;
+  for (int i = 0; i < timerCount; i++)
+    timers[i].pending = false;
+  wheelTime = now;
+}
+
+// 만기까지 남은 시간에 맞는 레벨/슬롯에 연결
+static void timerLink(uint8_t id) {
+  Timer &t = timers[id];
+  long delta = (long)(t.expires - wheelTime);
+  unsigned long target = t.expires;
+  uint8_t level = 0;
+
+  if (delta < 0) {
+    target = wheelTime; // 이미 지남: 다음 tick에 처리
+  } else if ((unsigned long)delta >= TW_RANGE) {
+    target = wheelTime + TW_RANGE - 1; // 범위 밖: 최상위 레벨에서 대기 후 재배치
+    level = TW_LEVELS - 1;
+  } else {
+    while (level < TW_LEVELS - 1 &&
+           (unsigned long)delta >= (1UL << (TW_SLOT_BITS * (level + 1))))
+      level++;
+  }
+
+  t.level = level;
+  t.slot = (target >> (TW_SLOT_BITS * level)) & TW_MASK;
+  t.next = wheel[level][t.slot];
+  wheel[level][t.slot] = id;
+  t.pending = true;
+}
+
+static void timerUnlink(uint8_t id) {
+  Timer &t = timers[id];
+  if (!t.pending)
+    return;
+  uint8_t *link = &wheel[t.level][t.slot];
+  while (*link != TIMER_NONE && *link != id)
+    link = &timers[*link].next;
+  if (*link == id)
+    *link = t.next;
+  t.pending = false;
+}
+
+// 상위 레벨 슬롯의 타이머들을 현재 시각 기준으로 다시 배치
+static void timerCascade(uint8_t level, uint8_t slot) {
+  uint8_t id = wheel[level][slot];
+  wheel[level][slot] = TIMER_NONE;
+  while (id != TIMER_NONE) {
+    uint8_t next = timers[id].next;
+    timerLink(id);
+    id = next;
+  }
+}
+
+// 콜백 등록 (setup에서 한 번만 호출), 실패 시 -1
+int timerCreate(TimerCallback callback) {
+  if (timerCount >= TIMER_MAX)
+    return -1;
+  timers[timerCount].callback = callback;
+  timers[timerCount].pending = false;
+  return timerCount++;
+}
+
+// delayMs 후 실행, periodMs > 0이면 이후 주기적으로 반복
+void timerStart(int id, unsigned long delayMs, unsigned long periodMs) {
+  if (id < 0 || id >= timerCount)
+    return;
+  timerUnlink(id);
+  timers[id].expires = millis() + delayMs;
+  timers[id].period = periodMs;
+  timerLink(id);
+}
+
+void timerStop(int id) {
+  if (id < 0 || id >= timerCount)
+    return;
+  timerUnlink(id);
+}
+
+// 가장 가까운 마감 시각 (대기 중인 타이머가 없으면 false)
+bool timerNextDeadline(unsigned long *deadline) {
+  bool found = false;
+  for (int i = 0; i < timerCount; i++) {
+    if (!timers[i].pending)
+      continue;
+    if (!found || (long)(timers[i].expires - *deadline) < 0)
+      *deadline = timers[i].expires;
+    found = true;
+  }
+  return found;
+}
+
+// now까지 밀린 tick을 처리하며 만기된 콜백 실행
+void timerWheelAdvance(unsigned long now) {
+  while ((long)(now - wheelTime) >= 0) {
+    uint8_t index = wheelTime & TW_MASK;
+    for (uint8_t level = 1; level < TW_LEVELS && index == 0; level++) {
+      index = (wheelTime >> (TW_SLOT_BITS * level)) & TW_MASK;
+      timerCascade(level, index);
+    }
+
+    uint8_t slot = wheelTime & TW_MASK;
+    uint8_t id;
+    while ((id = wheel[0][slot]) != TIMER_NONE) {
+      Timer &t = timers[id];
+      wheel[0][slot] = t.next;
+      t.pending = false;
+
+      if (t.period > 0) {
+        // 블로킹 애니메이션 등으로 밀린 주기는 따라잡지 않고 건너뜀
+        t.expires += t.period;
+        if ((long)(t.expires - now) <= 0)
+          t.expires = now + t.period;
+        timerLink(id);
+      }
+      t.callback();
+    }
+    wheelTime++;
+  }
+}
+
+// 다음 타이머 마감까지 대기, 그 사이 입력이 도착하면 즉시 깨어남
+// 반환값: 시리얼 입력 대기 중 여부
+bool idleUntilNextEvent() {
+  unsigned long deadline = 0;
+  bool hasDeadline = timerNextDeadline(&deadline);
+#if defined(TARGET_PC) && defined(DETERMINISTIC)
+  return detIdle(hasDeadline, deadline);
+#elif defined(TARGET_PC)
+  int timeout = -1;
+  if (hasDeadline) {
+    long remaining = (long)(deadline - millis());
+    timeout = remaining > 0 ? (int)remaining : 0;
+  }
+  struct pollfd pfd;
+  pfd.fd = STDIN_FILENO;
+  pfd.events = POLLIN;
+  pfd.revents = 0;
+  bool watchStdin = (currentInputMode == INPUT_SERIAL) && stdinOpen;
+  return poll(&pfd, watchStdin ? 1 : 0, timeout) > 0;
+#else
+  if (currentInputMode == INPUT_SERIAL && Serial.available() > 0)
+    return true;
+  if (hasDeadline && (long)(deadline - millis()) <= 0)
+    return false;
+#ifdef __AVR__
+  // millis 타이머(약 1ms) 또는 UART 수신 인터럽트로 깨어남
+  set_sleep_mode(SLEEP_MODE_IDLE);
+  sleep_mode();
+#endif
+  return currentInputMode == INPUT_SERIAL && Serial.available() > 0;
+#endif
+}
+
+// 200ms마다 현재 플레이어 위치 깜빡임
+void blinkTask() {
+  blinkState = !blinkState;
+  drawBoard(blinkState);
+}
+
+void inputTask() {
+  int selectedNode = readInput(currentInputMode);
+  if (selectedNode >= 0 && selectedNode < TOTAL_NODES) {
+    processTurn(selectedNode);
+    // 턴 처리 후 즉시 화면 갱신 및 깜빡임 주기 재시작
+    blinkState = true;
+    drawBoard(blinkState);
+    timerStart(blinkTimer, BLINK_INTERVAL, BLINK_INTERVAL);
+  }
+}
+
+// ============================================================================
+// 9. 메인 Setup & Loop
 // ============================================================================
 
 void setup() {
   displayInit();
   setBrightness(15);
   inputInit();
+  timerWheelInit(millis());
+  blinkTimer = timerCreate(blinkTask);
+  inputTimer = timerCreate(inputTask);
 
   Serial.println(F(""));
   Serial.println(F("========================================"));
@@ -907,6 +1237,7 @@ void setup() {
     drawBoard(false);
     displayDelay(200);
   }
+  timerStart(blinkTimer, BLINK_INTERVAL, BLINK_INTERVAL);
 }
 
 void loop() {
@@ -920,6 +1251,9 @@ void loop() {
     else
       Serial.println(F("   DRAW!"));
     Serial.println(F("========================================"));
+#ifdef TARGET_PC
+    strip.printTransferStats();
+#endif
     Serial.println(F(""));
     displayDelay(5000);
     Serial.println(F("Restarting game..."));
@@ -931,36 +1265,127 @@ void loop() {
       drawBoard(false);
       displayDelay(200);
     }
+    timerStart(blinkTimer, BLINK_INTERVAL, BLINK_INTERVAL);
     return;
   }
 
-  // 입력 대기 중 깜빡임 처리 (Non-blocking)
-  static unsigned long lastBlinkTime = 0;
-  static bool blinkState = false;
-  unsigned long currentMillis = millis();
+  // 깜빡임/자석 스캔은 타이머 휠에서 처리하고
+  // 다음 마감 시각까지는 입력을 기다리며 대기 (busy-poll 없음)
+  timerWheelAdvance(millis());
+  if (idleUntilNextEvent())
+    inputTask();
+}
 
-  if (currentMillis - lastBlinkTime >= 200) {
-    lastBlinkTime = currentMillis;
-    blinkState = !blinkState;
-    drawBoard(blinkState);
+// ============================================================================
+// 10. 결정적 시뮬레이션 모드 (Deterministic Lock-step, PC 전용)
+// ============================================================================
+
+// PC에서 -DDETERMINISTIC으로 빌드하면 활성화
+// - 시간: delay()/millis()가 가상 시간으로 동작 (실제로 잠들지 않음)
+// - 입력: stdin의 "<가상ms> <노드>" 스크립트를 해당 시각에 전달
+// 스크립트가 끝나고 DET_TAIL_MS가 지나면 프레임/카운터 digest를 출력하고 종료
+
+#ifdef DETERMINISTIC
+#define DET_MAX_EVENTS 1024
+#define DET_TAIL_MS 2000
+
+struct ScriptEvent {
+  unsigned long at; // 입력이 도착하는 가상 시각 (ms)
+  int node;
+};
+
+static ScriptEvent detScript[DET_MAX_EVENTS];
+static int detScriptCount = 0;
+static int detScriptPos = 0;
+static uint64_t detDigest = 14695981039346656037ULL; // FNV-1a 64
+static unsigned long detFrames = 0;
+static unsigned long detInputs = 0;
+
+static void detHash(uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    detDigest ^= (value >> (i * 8)) & 0xFF;
+    detDigest *= 1099511628211ULL;
   }
+}
 
-  int selectedNode = readInput(currentInputMode);
-  if (selectedNode >= 0 && selectedNode < TOTAL_NODES) {
-    processTurn(selectedNode);
-    // 턴 처리 후 즉시 화면 갱신 및 깜빡임 상태 초기화
-    blinkState = true;
-    drawBoard(blinkState);
-    lastBlinkTime = millis();
+// 스크립트 형식: 한 줄에 "<가상ms> <노드>", '#'으로 시작하면 주석
+void detBegin(FILE *in) {
+  char line[64];
+  while (detScriptCount < DET_MAX_EVENTS && fgets(line, sizeof(line), in)) {
+    unsigned long at;
+    int node;
+    if (line[0] == '#' || sscanf(line, "%lu %d", &at, &node) != 2)
+      continue;
+    detScript[detScriptCount].at = at;
+    detScript[detScriptCount].node = node;
+    detScriptCount++;
   }
+}
+
+// 현재 가상 시각까지 도착한 입력 (없으면 -1)
+int detPollScript() {
+  if (detScriptPos >= detScriptCount || detScript[detScriptPos].at > millis())
+    return -1;
+  detInputs++;
+  return detScript[detScriptPos++].node;
+}
+
+// 표시된 프레임의 가상 시각과 픽셀을 digest에 누적
+void detRecordFrame() {
+  detHash((uint32_t)millis());
+  for (int i = 0; i < LED_COUNT; i++)
+    detHash(strip.getPixelColor(i));
+  detHash(strip.getBrightness());
+  detFrames++;
+}
 
-  // displayDelay(50) 제거 (Non-blocking 루프를 위해)
-  // 대신 짧은 지연만 줌
-  delay(10);
+void detFinish() {
+  std::printf("DIGEST:frames=%lu inputs=%lu vtime=%lu fnv=%016llx\n",
+              detFrames, detInputs, millis(),
+              (unsigned long long)detDigest);
+  std::fflush(stdout);
+  strip.printTransferStats();
+  std::exit(0);
 }
 
+// 다음 타이머 마감 또는 다음 스크립트 입력 시각으로 가상 시간을 건너뜀
+bool detIdle(bool hasDeadline, unsigned long deadline) {
+  unsigned long now = millis();
+  unsigned long target = deadline;
+  bool hasTarget = hasDeadline;
+
+  if (detScriptPos < detScriptCount) {
+    unsigned long at = detScript[detScriptPos].at;
+    if (!hasTarget || (long)(at - target) < 0)
+      target = at;
+    hasTarget = true;
+  } else {
+    unsigned long end =
+        (detScriptCount > 0 ? detScript[detScriptCount - 1].at : 0) +
+        DET_TAIL_MS;
+    if (!hasTarget || (long)(end - target) <= 0 || (long)(now - end) >= 0)
+      detFinish();
+  }
+
+  if ((long)(target - now) > 0)
+    virtualMicros = target * 1000UL;
+  return currentInputMode == INPUT_SERIAL && detScriptPos < detScriptCount &&
+         detScript[detScriptPos].at <= millis();
+}
+#endif
+
 #ifdef TARGET_PC
-int main() {
+int main(int argc, char **argv) {
+  (void)argc;
+  (void)argv;
+#ifdef DETERMINISTIC
+  // 사용법: ./실행파일 < 입력스크립트
+  detBegin(stdin);
+#else
+  // stdin 버퍼 없음: fgets()가 한 줄만 읽고 나머지는 커널에 남겨 poll()이 볼 수 있게
+  // (버퍼가 있으면 함께 도착한 다음 줄이 stdio 안에 숨어 다음 입력까지 처리가 밀림)
+  setvbuf(stdin, NULL, _IONBF, 0);
+#endif
   setup();
   Serial.println("Enter node numbers (0-35) to play:");
   Serial.println("Example moves:");